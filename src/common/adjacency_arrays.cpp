@@ -0,0 +1,60 @@
+#include "adjacency_arrays.h"
+
+#include <algorithm>
+
+namespace utils {
+AdjacencyArrays AdjacencyArrays::FromEdges(uint64_t numVertices, std::span<EdgeType const> edges)
+{
+    AdjacencyArrays result;
+    auto &offsets = result.offsets;
+    auto &targets = result.targets;
+
+    // counting sort of both edge directions by source
+    offsets.assign(numVertices + 1, 0);
+    for (auto [u, v]: edges) {
+        if (u != v) {
+            ++offsets[u + 1];
+            ++offsets[v + 1];
+        }
+    }
+    result.PrefixSums();
+
+    targets.resize(offsets.back());
+    std::vector<uint64_t> position(offsets.begin(), offsets.end() - 1);
+    for (auto [u, v]: edges) {
+        if (u != v) {
+            targets[position[u]++] = v;
+            targets[position[v]++] = u;
+        }
+    }
+
+    result.SortAndCompact();
+    return result;
+}
+
+void AdjacencyArrays::PrefixSums()
+{
+    for (uint64_t v = 0; v + 1 < offsets.size(); ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+}
+
+void AdjacencyArrays::SortAndCompact()
+{
+    uint64_t const numVertices = NumVertices();
+
+    uint64_t size = 0;
+    for (uint64_t v = 0; v < numVertices; ++v) {
+        auto first = targets.begin() + offsets[v];
+        auto last = targets.begin() + offsets[v + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+
+        offsets[v] = size;
+        size = std::copy(first, last, targets.begin() + size) - targets.begin();
+    }
+    offsets[numVertices] = size;
+    targets.resize(size);
+    targets.shrink_to_fit();
+}
+} // namespace utils
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdexcept>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <span>
+
+namespace utils {
+// Symmetric adjacency in CSR layout: sorted neighbour lists without
+// self-loops and duplicate edges.
+struct AdjacencyArrays {
+    using EdgeType = std::pair<uint32_t, uint32_t>;
+
+    std::vector<uint64_t> offsets { 0 };
+    std::vector<uint32_t> targets;
+
+    static AdjacencyArrays FromEdges(uint64_t numVertices, std::span<EdgeType const> edges);
+
+    // Builds from per-vertex records of a symmetric source (DshuGraph, DshuV2Graph):
+    // every edge is taken from its lower endpoint, ids out of range are rejected.
+    template <typename Source>
+    static AdjacencyArrays FromAdjacency(Source const& src);
+
+    uint64_t NumVertices() const noexcept
+    {
+        return offsets.size() - 1;
+    }
+
+    uint64_t NumEdges() const noexcept
+    {
+        return targets.size() / 2;
+    }
+
+    std::span<uint32_t const> Neighbours(uint64_t v) const noexcept
+    {
+        return {targets.data() + offsets[v], targets.data() + offsets[v + 1]};
+    }
+
+    // f(v, neighbours) for all vertices in id order.
+    template <typename Func>
+    void ForEachVertex(Func&& f) const
+    {
+        for (uint64_t v = 0; v < NumVertices(); ++v) {
+            f(v, Neighbours(v));
+        }
+    }
+
+private:
+    // offsets[v + 1] hold degrees on entry
+    void PrefixSums();
+    // sorts every list and squeezes duplicates out in place
+    void SortAndCompact();
+};
+
+template <typename Source>
+AdjacencyArrays AdjacencyArrays::FromAdjacency(Source const& src)
+{
+    uint64_t const numVertices = src.NumVertices();
+
+    AdjacencyArrays result;
+    result.offsets.assign(numVertices + 1, 0);
+
+    src.ForEachVertex([&result, numVertices](uint64_t v, auto neighbours) {
+        for (uint64_t u: neighbours) {
+            if (u >= numVertices) {
+                throw std::runtime_error("Neighbour id is out of range");
+            }
+            if (v < u) {
+                ++result.offsets[v + 1];
+                ++result.offsets[u + 1];
+            }
+        }
+    });
+    result.PrefixSums();
+
+    result.targets.resize(result.offsets.back());
+    std::vector<uint64_t> position(result.offsets.begin(), result.offsets.end() - 1);
+    src.ForEachVertex([&result, &position](uint64_t v, auto neighbours) {
+        for (uint64_t u: neighbours) {
+            if (v < u) {
+                result.targets[position[v]++] = u;
+                result.targets[position[u]++] = v;
+            }
+        }
+    });
+
+    result.SortAndCompact();
+    return result;
+}
+} // namespace utils
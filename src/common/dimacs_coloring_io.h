@@ -6,9 +6,19 @@
 
 #include <boost/range/iterator_range.hpp>
 
+#include <unordered_map>
+#include <string_view>
+#include <type_traits>
 #include <ostream>
 #include <iomanip>
+#include <utility>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include "dimacs_parser.h"
+#include "dimacs_writer.h"
+#include "mapped_file.h"
 
 namespace utils {
 template<typename VertexListGraph>
@@ -25,8 +35,8 @@ public:
     struct Comments {
         static void Description(std::ostream &out, VertexListGraph const&) noexcept
         {
-            out << "c SOURCE: Dmitriy Shustrov (shustrov38@gmail.com)" << std::endl;
-            out << "c DESCRIPTION: Planar graph based on Voronoi Diagram with random edges removed." << std::endl;
+            out << "c SOURCE: Dmitriy Shustrov (shustrov38@gmail.com)\n";
+            out << "c DESCRIPTION: Planar graph based on Voronoi Diagram with random edges removed.\n";
         }
 
         static void Density(std::ostream &out, VertexListGraph const& g) noexcept
@@ -43,18 +53,18 @@ public:
             double maxPossibleEdges = (numVerts * (numVerts - 1)) / 2.0;
             double edgeDensity = numEdges / maxPossibleEdges;
 
-            out << "c STATS: Average vertex degree = " << std::fixed << std::setprecision(2) << avgDegree << std::endl;
-            out << "c STATS: Edge density = " << std::fixed << std::setprecision(4) << edgeDensity << std::endl;
+            out << "c STATS: Average vertex degree = " << std::fixed << std::setprecision(2) << avgDegree << '\n';
+            out << "c STATS: Edge density = " << std::fixed << std::setprecision(4) << edgeDensity << '\n';
         }
 
         static void Separator(std::ostream &out, VertexListGraph const&) noexcept
         {
-            out << "c " << std::endl;
+            out << "c \n";
         }
     };
 
     template <class... Commenters>
-    static void Write(VertexListGraph const& g, std::ostream &out, Commenters&&... comments) noexcept 
+    static void Write(VertexListGraph const& g, std::ostream &out, Commenters&&... comments)
     {
         // Write problem comments
         // Format: c comments
@@ -67,82 +77,49 @@ public:
         // Format: p edge <vertices> <edges>
         out << "p edge " << numVerts << " " << numEdges << "\n";
 
-        std::vector<Vertex> vertices;
-        vertices.reserve(numVerts);
-        for (auto v: boost::make_iterator_range(boost::vertices(g))) {
-            vertices.emplace_back(v);
-        }
-
-        std::map<Vertex, VertexSizeType> order;
-        for (VertexSizeType i = 0; i < vertices.size(); ++i) {
-            order[vertices[i]] = i;
-        }
-
-        // Write edge lines
+        // Write edge lines, formatted straight from the edge range
         // Format: e <vertex1> <vertex2>
-        for (auto e: boost::make_iterator_range(boost::edges(g))) {
-            Vertex source = boost::source(e, g);
-            Vertex target = boost::target(e, g);
-
-            // DIMACS format uses 1-based vertex numbering
-            VertexSizeType u = order[source] + 1;
-            VertexSizeType v = order[target] + 1;
-
-            out << "e " << u << " " << v << "\n";
+        auto [first, last] = boost::edges(g);
+        if constexpr (std::is_integral_v<Vertex>) {
+            // vecS: descriptors are already 0-based indices
+            auto const endpoints = [&g](Edge const& e) {
+                return std::pair<uint64_t, uint64_t>(boost::source(e, g), boost::target(e, g));
+            };
+            WriteDimacsEdges(out, first, last, endpoints, std::thread::hardware_concurrency());
+        } else {
+            std::unordered_map<Vertex, VertexSizeType> order;
+            order.reserve(numVerts);
+            for (auto v: boost::make_iterator_range(boost::vertices(g))) {
+                order.emplace(v, order.size());
+            }
+            auto const endpoints = [&g, &order](Edge const& e) {
+                return std::pair<uint64_t, uint64_t>(order.at(boost::source(e, g)), order.at(boost::target(e, g)));
+            };
+            WriteDimacsEdges(out, first, last, endpoints, std::thread::hardware_concurrency());
         }
     }
 
     template <typename Order>
-    static void Read(VertexListGraph &g, Order order, std::istream &in)
+    static void Read(VertexListGraph &g, Order order, std::string_view text, size_t numThreads = 1)
     {
-        VertexSizeType numVertices = 0;
-        EdgeSizeType numEdges = 0;
-
-        bool headerParsed = false;
-
-        for (std::string line; std::getline(in, line);) {
-            if (line.empty()) {
-                continue;
-            }
-
-            if (line[0] == 'c') {
-                continue;
-            } else if (line[0] == 'p') {
-                std::istringstream iss(line);
-                char p;
-                std::string type;
-                iss >> p >> type >> numVertices >> numEdges;
-                headerParsed = true;
-            }
-        }
-
-        if (!headerParsed) {
-            throw std::runtime_error("There is no problem description");
-        }
+        auto problem = ParseDimacs(text, numThreads);
 
         g.clear();
-        
-        for (size_t i = 0; i < numVertices; ++i) {
+
+        for (size_t i = 0; i < problem.numVertices; ++i) {
             Vertex v = boost::add_vertex({}, g);
             order[v] = i;
         }
 
-        in.clear();
-        in.seekg(0, std::ios::beg);
-        
-        for (std::string line; std::getline(in, line);) {
-            if (line.empty() || line.starts_with('c') || line.starts_with('p')) {
-                continue;
-            }
-
-            if (line.starts_with('e')) {
-                std::istringstream iss(line);
-                char e;
-                std::size_t u, v;
-                iss >> e >> u >> v;
-                boost::add_edge(u - 1, v - 1, g);
-            }
+        for (auto [u, v]: problem.edges) {
+            boost::add_edge(u, v, g);
         }
     }
+
+    template <typename Order>
+    static void Read(VertexListGraph &g, Order order, std::istream &in, size_t numThreads = 1)
+    {
+        Read(g, order, ReadAll(in), numThreads);
+    }
 };
 } // namespace utils
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "dimacs_parser.h"
+
+#include <system_error>
+#include <stdexcept>
+#include <exception>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <string>
+
+namespace utils {
+namespace {
+struct ChunkResult {
+    bool hasHeader { false };
+    uint64_t numVertices { 0 };
+    uint64_t numEdges { 0 };
+
+    uint64_t maxVertex { 0 };
+    std::vector<DimacsProblem::EdgeType> edges;
+
+    std::exception_ptr error;
+};
+
+inline bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline char const *SkipSpaces(char const *p, char const *end)
+{
+    while (p != end && IsSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+inline char const *SkipToken(char const *p, char const *end)
+{
+    while (p != end && !IsSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+inline char const *ParseNumber(char const *p, char const *end, uint64_t &value)
+{
+    p = SkipSpaces(p, end);
+    auto [ptr, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc{}) {
+        return nullptr;
+    }
+    return ptr;
+}
+
+[[noreturn]] void ThrowMalformed(char const *what, char const *begin, char const *end)
+{
+    throw std::runtime_error(std::string("Malformed ") + what + " line: '" + std::string(begin, end) + "'");
+}
+
+void ParseChunk(char const *p, char const *end, ChunkResult &result)
+{
+    // ~6 bytes per edge line is the lower bound for non-trivial graphs
+    result.edges.reserve((end - p) / 8);
+
+    while (p != end) {
+        auto *lineEnd = static_cast<char const *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        if (*p == 'e') {
+            uint64_t u, v;
+            auto *cur = ParseNumber(p + 1, lineEnd, u);
+            cur = cur ? ParseNumber(cur, lineEnd, v) : nullptr;
+
+            // DIMACS format uses 1-based vertex numbering
+            if (!cur || u == 0 || v == 0 || std::max(u, v) > std::numeric_limits<uint32_t>::max()) {
+                ThrowMalformed("edge", p, lineEnd);
+            }
+
+            result.maxVertex = std::max(result.maxVertex, std::max(u, v));
+            result.edges.emplace_back(u - 1, v - 1);
+        } else if (*p == 'p') {
+            // Format: p <type> <vertices> <edges>
+            auto *cur = SkipToken(SkipSpaces(p + 1, lineEnd), lineEnd);
+            cur = ParseNumber(cur, lineEnd, result.numVertices);
+            cur = cur ? ParseNumber(cur, lineEnd, result.numEdges) : nullptr;
+            if (!cur) {
+                ThrowMalformed("problem", p, lineEnd);
+            }
+            result.hasHeader = true;
+        }
+
+        p = (lineEnd == end ? end : lineEnd + 1);
+    }
+}
+} // namespace
+
+DimacsProblem ParseDimacs(std::string_view text, size_t numThreads)
+{
+    static size_t constexpr MIN_CHUNK_SIZE = 4 << 20;
+
+    size_t numChunks = std::clamp<size_t>(text.size() / MIN_CHUNK_SIZE, 1, std::max<size_t>(numThreads, 1));
+
+    std::vector<char const *> bounds { text.data() };
+    char const *end = text.data() + text.size();
+    for (size_t i = 1; i < numChunks; ++i) {
+        char const *p = std::max(bounds.back(), text.data() + i * (text.size() / numChunks));
+        auto *lineEnd = static_cast<char const *>(std::memchr(p, '\n', end - p));
+        bounds.emplace_back(lineEnd ? lineEnd + 1 : end);
+    }
+    bounds.emplace_back(end);
+
+    std::vector<ChunkResult> chunks(numChunks);
+    auto worker = [&bounds, &chunks](size_t i) {
+        try {
+            ParseChunk(bounds[i], bounds[i + 1], chunks[i]);
+        } catch (...) {
+            chunks[i].error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numChunks; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto &t: threads) {
+        t.join();
+    }
+
+    DimacsProblem problem;
+    bool headerParsed = false;
+    uint64_t maxVertex = 0;
+    size_t totalEdges = 0;
+
+    for (auto &chunk: chunks) {
+        if (chunk.error) {
+            std::rethrow_exception(chunk.error);
+        }
+        // the last problem line wins
+        if (chunk.hasHeader) {
+            headerParsed = true;
+            problem.numVertices = chunk.numVertices;
+            problem.numEdges = chunk.numEdges;
+        }
+        maxVertex = std::max(maxVertex, chunk.maxVertex);
+        totalEdges += chunk.edges.size();
+    }
+
+    if (!headerParsed) {
+        throw std::runtime_error("There is no problem description");
+    }
+
+    problem.numVertices = std::max(problem.numVertices, maxVertex);
+
+    if (numChunks == 1) {
+        problem.edges = std::move(chunks[0].edges);
+    } else {
+        problem.edges.reserve(totalEdges);
+        for (auto &chunk: chunks) {
+            problem.edges.insert(problem.edges.end(), chunk.edges.begin(), chunk.edges.end());
+            chunk.edges = {};
+        }
+    }
+
+    return problem;
+}
+} // namespace utils
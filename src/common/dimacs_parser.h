@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace utils {
+struct DimacsProblem {
+    using EdgeType = std::pair<uint32_t, uint32_t>;
+
+    // max of the `p` line value and the largest vertex met in `e` lines
+    uint64_t numVertices { 0 };
+    // value from the `p` line
+    uint64_t numEdges { 0 };
+
+    // 0-based endpoints in file order
+    std::vector<EdgeType> edges;
+};
+
+// Single pass parser of DIMACS `p`/`e` lines. Text is split at line boundaries
+// into chunks parsed by up to `numThreads` threads, the result keeps file order.
+DimacsProblem ParseDimacs(std::string_view text, size_t numThreads = 1);
+} // namespace utils
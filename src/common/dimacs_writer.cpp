@@ -0,0 +1,11 @@
+#include "dimacs_writer.h"
+
+namespace utils {
+void WriteDimacsEdges(std::ostream &out, std::span<std::pair<uint32_t, uint32_t> const> edges, size_t numThreads)
+{
+    auto const endpoints = [](std::pair<uint32_t, uint32_t> const& edge) {
+        return edge;
+    };
+    WriteDimacsEdges(out, edges.begin(), edges.end(), endpoints, numThreads);
+}
+} // namespace utils
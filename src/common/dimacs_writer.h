@@ -0,0 +1,136 @@
+#pragma once
+
+#include <system_error>
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <barrier>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <span>
+
+namespace utils {
+// Longest `e <u> <v>\n` line with 64-bit ids.
+static size_t constexpr DIMACS_MAX_EDGE_LINE_SIZE = 2 * 20 + 4;
+
+// Formats one `e u v` line of 0-based endpoints, returns the end of the line.
+inline char *FormatDimacsEdge(char *ptr, uint64_t u, uint64_t v) noexcept
+{
+    // DIMACS format uses 1-based vertex numbering
+    *ptr++ = 'e';
+    *ptr++ = ' ';
+    ptr = std::to_chars(ptr, ptr + 20, u + 1).ptr;
+    *ptr++ = ' ';
+    ptr = std::to_chars(ptr, ptr + 20, v + 1).ptr;
+    *ptr++ = '\n';
+    return ptr;
+}
+
+// Writes `e` lines of the edges in [first, last) in order, endpoints(edge) gives their
+// 0-based ids as a pair. The edges are formatted straight from the range: every round
+// the calling thread hands one block to each of up to `numThreads` persistent workers,
+// which format into reusable buffers, then writes the blocks sequentially.
+template <typename Iterator, typename Endpoints>
+void WriteDimacsEdges(
+    std::ostream &out, Iterator first, Iterator last, Endpoints const& endpoints, size_t numThreads = 1
+)
+{
+    // endpoints may be 64-bit, so a block takes up to 2.75 MiB of text
+    static size_t constexpr EDGES_PER_BLOCK = 1 << 16;
+    // formatting outruns the stream long before this
+    static size_t constexpr MAX_THREADS = 8;
+
+    numThreads = std::clamp<size_t>(numThreads, 1, MAX_THREADS);
+
+    std::vector<std::string> buffers(numThreads, std::string(EDGES_PER_BLOCK * DIMACS_MAX_EDGE_LINE_SIZE, '\0'));
+    std::vector<size_t> sizes(numThreads, 0);
+    // block of every slot in the current round
+    std::vector<Iterator> starts(numThreads, last);
+    std::vector<size_t> counts(numThreads, 0);
+
+    auto format = [&](size_t slot) {
+        char *ptr = buffers[slot].data();
+        auto it = starts[slot];
+        for (size_t i = 0; i < counts[slot]; ++i, ++it) {
+            auto const [u, v] = endpoints(*it);
+            ptr = FormatDimacsEdge(ptr, u, v);
+        }
+        sizes[slot] = ptr - buffers[slot].data();
+    };
+
+    // rounds have two phases: the blocks are handed out, then they are all formatted
+    std::barrier sync(numThreads);
+    std::atomic_bool done = false;
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    for (size_t slot = 1; slot < numThreads; ++slot) {
+        try {
+            workers.emplace_back([&format, &sync, &done, slot]() {
+                while (true) {
+                    sync.arrive_and_wait();
+                    if (done) {
+                        return;
+                    }
+                    format(slot);
+                    sync.arrive_and_wait();
+                }
+            });
+        } catch (std::system_error const&) {
+            // fewer workers will do, the slots without a thread are dropped from the barrier
+            for (size_t missing = slot; missing < numThreads; ++missing) {
+                sync.arrive_and_drop();
+            }
+            numThreads = slot;
+            break;
+        }
+    }
+
+    // workers are released and joined on every exit, exceptions of the stream included
+    bool formatting = false;
+    auto release = [&sync, &done, &workers, &formatting]() {
+        if (formatting) {
+            sync.arrive_and_wait();
+        }
+        done = true;
+        sync.arrive_and_wait();
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    };
+
+    try {
+        while (first != last) {
+            for (size_t slot = 0; slot < numThreads; ++slot) {
+                starts[slot] = first;
+                counts[slot] = 0;
+                while (first != last && counts[slot] < EDGES_PER_BLOCK) {
+                    ++first;
+                    ++counts[slot];
+                }
+            }
+
+            sync.arrive_and_wait();
+            formatting = true;
+            format(0);
+            sync.arrive_and_wait();
+            formatting = false;
+
+            for (size_t slot = 0; slot < numThreads; ++slot) {
+                out.write(buffers[slot].data(), sizes[slot]);
+            }
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+    release();
+}
+
+// WriteDimacsEdges of 0-based edges held in memory.
+void WriteDimacsEdges(std::ostream &out, std::span<std::pair<uint32_t, uint32_t> const> edges, size_t numThreads = 1);
+} // namespace utils
@@ -0,0 +1,21 @@
+#include "dshu_graph.h"
+
+#include <utility>
+
+namespace utils {
+DshuGraph::DshuGraph(MappedFile file)
+    : mFile(std::move(file))
+{
+    if (!IsDshu(mFile.View()) || mFile.Size() < HEADER_SIZE) {
+        throw std::runtime_error("DSHU: bad magic or truncated header");
+    }
+
+    mNumVertices = Load<uint32_t>(mFile.Data() + MAGIC_SIZE);
+    mNumEdges = Load<uint64_t>(mFile.Data() + MAGIC_SIZE + sizeof(uint32_t));
+    mRecordsStart = HEADER_SIZE + uint64_t(mNumVertices) * sizeof(uint64_t);
+
+    if (mFile.Size() < mRecordsStart) {
+        throw std::runtime_error("DSHU: truncated offset table");
+    }
+}
+} // namespace utils
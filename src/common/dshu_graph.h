@@ -0,0 +1,124 @@
+#pragma once
+
+#include <string_view>
+#include <stdexcept>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+
+#include "mapped_file.h"
+
+namespace utils {
+// Zero-copy view of the DSHUV1.0 binary graph written by generator huge mode.
+//
+// Layout (little endian, no padding):
+//      char[8]                  magic "DSHUV1.0"
+//      uint32_t                 number of vertices n
+//      uint64_t                 number of edges
+//      uint64_t[n]              absolute file offset of every vertex record
+//      { uint8_t, uint32_t[] }  vertex record: degree and 0-based neighbours
+class DshuGraph {
+public:
+    static std::string_view constexpr MAGIC_VER_1_0 = "DSHUV1.0";
+
+    static size_t constexpr MAGIC_SIZE = 8;
+    static size_t constexpr HEADER_SIZE = MAGIC_SIZE + sizeof(uint32_t) + sizeof(uint64_t);
+
+    class NeighbourIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = uint32_t;
+
+        NeighbourIterator() = default;
+        explicit NeighbourIterator(char const *ptr) : mPtr(ptr) {}
+
+        uint32_t operator*() const noexcept { return Load<uint32_t>(mPtr); }
+
+        NeighbourIterator& operator++() noexcept
+        {
+            mPtr += sizeof(uint32_t);
+            return *this;
+        }
+
+        NeighbourIterator operator++(int) noexcept
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(NeighbourIterator const&) const = default;
+
+    private:
+        char const *mPtr { nullptr };
+    };
+
+    struct NeighbourRange {
+        NeighbourIterator first;
+        NeighbourIterator last;
+
+        NeighbourIterator begin() const noexcept { return first; }
+        NeighbourIterator end() const noexcept { return last; }
+    };
+
+    static bool IsDshu(std::string_view data) noexcept
+    {
+        return data.starts_with(MAGIC_VER_1_0);
+    }
+
+    explicit DshuGraph(MappedFile file);
+
+    uint32_t NumVertices() const noexcept { return mNumVertices; }
+    uint64_t NumEdges() const noexcept { return mNumEdges; }
+
+    uint8_t Degree(uint32_t v) const
+    {
+        return Load<uint8_t>(Record(v));
+    }
+
+    NeighbourRange Neighbours(uint32_t v) const
+    {
+        char const *record = Record(v);
+        char const *first = record + sizeof(uint8_t);
+        return {NeighbourIterator(first), NeighbourIterator(first + Load<uint8_t>(record) * sizeof(uint32_t))};
+    }
+
+    // f(v, NeighbourRange) for all vertices in id order.
+    template <typename Func>
+    void ForEachVertex(Func&& f) const
+    {
+        for (uint32_t v = 0; v < mNumVertices; ++v) {
+            f(v, Neighbours(v));
+        }
+    }
+
+private:
+    template <typename T>
+    static T Load(char const *ptr) noexcept
+    {
+        T value;
+        std::memcpy(&value, ptr, sizeof(T));
+        return value;
+    }
+
+    char const *Record(uint32_t v) const
+    {
+        uint64_t offset = Load<uint64_t>(mFile.Data() + HEADER_SIZE + v * sizeof(uint64_t));
+        if (offset < mRecordsStart || offset >= mFile.Size()
+            || offset + sizeof(uint8_t) + Load<uint8_t>(mFile.Data() + offset) * sizeof(uint32_t) > mFile.Size())
+        {
+            throw std::runtime_error("DSHU: vertex record is out of file bounds");
+        }
+        return mFile.Data() + offset;
+    }
+
+    MappedFile mFile;
+
+    uint32_t mNumVertices { 0 };
+    uint64_t mNumEdges { 0 };
+    uint64_t mRecordsStart { 0 };
+};
+} // namespace utils
@@ -0,0 +1,202 @@
+#include "dshu_v2.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace utils {
+uint32_t DshuV2::Checksum(Header const& header) noexcept
+{
+    auto const *bytes = reinterpret_cast<uint8_t const *>(&header);
+
+    uint32_t crc = 0xffffffffu;
+    for (size_t i = 0; i < offsetof(Header, checksum); ++i) {
+        crc ^= bytes[i];
+        for (int32_t k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0xedb88320u & -(crc & 1u));
+        }
+    }
+    return ~crc;
+}
+
+DshuV2Graph::DshuV2Graph(MappedFile file)
+    : mFile(std::move(file))
+{
+    if (!DshuV2::IsDshuV2(mFile.View()) || mFile.Size() < sizeof(DshuV2::Header)) {
+        throw std::runtime_error("DSHU v2: bad magic or truncated header");
+    }
+
+    std::memcpy(&mHeader, mFile.Data(), sizeof(DshuV2::Header));
+    if (mHeader.checksum != DshuV2::Checksum(mHeader)) {
+        throw std::runtime_error("DSHU v2: header checksum mismatch");
+    }
+
+    if (mHeader.blockSize == 0) {
+        throw std::runtime_error("DSHU v2: zero block size");
+    }
+
+    uint64_t const numBlocks = (mHeader.numVertices + mHeader.blockSize - 1) / mHeader.blockSize;
+    uint64_t const adjacencyEnd = mHeader.adjacencyOffset + mHeader.adjacencySize;
+    if (mHeader.adjacencyOffset < sizeof(DshuV2::Header) + numBlocks * sizeof(uint64_t) || adjacencyEnd > mFile.Size()) {
+        throw std::runtime_error("DSHU v2: adjacency section is out of file bounds");
+    }
+
+    if (HasCoordinates()) {
+        uint64_t const coordinatesEnd = mHeader.coordinatesOffset + mHeader.numVertices * sizeof(DshuV2::Coordinate);
+        if (mHeader.coordinatesOffset < adjacencyEnd || coordinatesEnd > mFile.Size()) {
+            throw std::runtime_error("DSHU v2: coordinates section is out of file bounds");
+        }
+    }
+
+    mIndex = mFile.Data() + sizeof(DshuV2::Header);
+    mAdjacency = mFile.Data() + mHeader.adjacencyOffset;
+
+    for (uint64_t block = 0; block < numBlocks; ++block) {
+        uint64_t offset;
+        std::memcpy(&offset, mIndex + block * sizeof(uint64_t), sizeof(uint64_t));
+        if (offset >= mHeader.adjacencySize) {
+            throw std::runtime_error("DSHU v2: block index is out of adjacency bounds");
+        }
+    }
+}
+
+DshuV2::Coordinate DshuV2Graph::Coordinates(uint64_t v) const noexcept
+{
+    int64_t xy[2];
+    std::memcpy(xy, mFile.Data() + mHeader.coordinatesOffset + v * sizeof(xy), sizeof(xy));
+    return {xy[0], xy[1]};
+}
+
+char const *DshuV2Graph::Record(uint64_t v) const
+{
+    uint64_t offset;
+    std::memcpy(&offset, mIndex + (v / mHeader.blockSize) * sizeof(uint64_t), sizeof(uint64_t));
+
+    char const *ptr = mAdjacency + offset;
+    for (uint64_t i = v % mHeader.blockSize; i > 0; --i) {
+        uint64_t degree;
+        ptr = varint::Decode(ptr, AdjacencyEnd(), degree);
+        for (uint64_t k = 0; k < degree; ++k) {
+            ptr = varint::Skip(ptr, AdjacencyEnd());
+        }
+    }
+    return ptr;
+}
+
+DshuV2Writer::DshuV2Writer(std::filesystem::path const& path, uint64_t numVertices, uint32_t blockSize)
+    : mStream(path, std::ios::binary)
+    , mHeader {}
+{
+    if (!mStream.is_open()) {
+        throw std::runtime_error("Unable to open file for writing: " + path.string());
+    }
+    if (blockSize == 0) {
+        throw std::invalid_argument("DSHU v2: zero block size");
+    }
+
+    std::memcpy(mHeader.magic, DshuV2::MAGIC_VER_2_0.data(), sizeof(mHeader.magic));
+    mHeader.numVertices = numVertices;
+    mHeader.blockSize = blockSize;
+
+    // the block index has a known size, records are streamed right after it
+    uint64_t const numBlocks = (numVertices + blockSize - 1) / blockSize;
+    mIndex.reserve(numBlocks);
+    mHeader.adjacencyOffset = sizeof(DshuV2::Header) + numBlocks * sizeof(uint64_t);
+
+    mStream.seekp(mHeader.adjacencyOffset);
+}
+
+void DshuV2Writer::AddVertex(std::span<uint32_t> neighbours)
+{
+    if (mNumAdded == mHeader.numVertices) {
+        throw std::logic_error("DSHU v2: too many vertices");
+    }
+
+    uint64_t const v = mNumAdded++;
+
+    std::sort(neighbours.begin(), neighbours.end());
+    auto last = std::unique(neighbours.begin(), neighbours.end());
+    last = std::remove(neighbours.begin(), last, static_cast<uint32_t>(v));
+    neighbours = neighbours.first(last - neighbours.begin());
+
+    if (v % mHeader.blockSize == 0) {
+        mIndex.emplace_back(mHeader.adjacencySize);
+    }
+
+    size_t const size = mBuffer.size();
+    mBuffer.resize(size + (neighbours.size() + 1) * varint::MAX_SIZE);
+
+    char *ptr = varint::Encode(mBuffer.data() + size, neighbours.size());
+    uint64_t prev = v;
+    for (size_t i = 0; i < neighbours.size(); ++i) {
+        if (i == 0) {
+            ptr = varint::Encode(ptr, varint::ZigZag(int64_t(neighbours[i]) - int64_t(v)));
+        } else {
+            ptr = varint::Encode(ptr, neighbours[i] - prev);
+        }
+        prev = neighbours[i];
+    }
+
+    mBuffer.resize(ptr - mBuffer.data());
+    mHeader.adjacencySize += mBuffer.size() - size;
+    mDegreeSum += neighbours.size();
+
+    if (mBuffer.size() >= (1 << 20)) {
+        Flush();
+    }
+}
+
+void DshuV2Writer::AddCoordinates(int64_t x, int64_t y)
+{
+    if (mNumAdded != mHeader.numVertices) {
+        throw std::logic_error("DSHU v2: coordinates must follow all vertices");
+    }
+    if (mNumCoordinates == mHeader.numVertices) {
+        throw std::logic_error("DSHU v2: too many coordinates");
+    }
+
+    if (mNumCoordinates++ == 0) {
+        Flush();
+        mHeader.coordinatesOffset = mHeader.adjacencyOffset + mHeader.adjacencySize;
+    }
+
+    int64_t const xy[2] = {x, y};
+    mBuffer.insert(mBuffer.end(), reinterpret_cast<char const *>(xy), reinterpret_cast<char const *>(xy + 2));
+
+    if (mBuffer.size() >= (1 << 20)) {
+        Flush();
+    }
+}
+
+void DshuV2Writer::Finish()
+{
+    if (mNumAdded != mHeader.numVertices) {
+        throw std::logic_error("DSHU v2: not all vertices are written");
+    }
+    if (mNumCoordinates != 0 && mNumCoordinates != mHeader.numVertices) {
+        throw std::logic_error("DSHU v2: not all coordinates are written");
+    }
+
+    Flush();
+
+    mHeader.numEdges = mDegreeSum / 2;
+    if (mNumCoordinates != 0) {
+        mHeader.flags |= DshuV2::HAS_COORDINATES;
+    }
+    mHeader.checksum = DshuV2::Checksum(mHeader);
+
+    mStream.seekp(0);
+    mStream.write(reinterpret_cast<char const *>(&mHeader), sizeof(mHeader));
+    mStream.write(reinterpret_cast<char const *>(mIndex.data()), mIndex.size() * sizeof(uint64_t));
+    mStream.flush();
+
+    if (!mStream) {
+        throw std::runtime_error("DSHU v2: write failed");
+    }
+}
+
+void DshuV2Writer::Flush()
+{
+    mStream.write(mBuffer.data(), mBuffer.size());
+    mBuffer.clear();
+}
+} // namespace utils
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <stdexcept>
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+#include <span>
+
+#include "mapped_file.h"
+
+namespace utils {
+namespace varint {
+// bytes of the longest uint64_t
+inline size_t constexpr MAX_SIZE = 10;
+
+inline char *Encode(char *ptr, uint64_t value) noexcept
+{
+    while (value >= 0x80) {
+        *ptr++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *ptr++ = static_cast<char>(value);
+    return ptr;
+}
+
+inline char const *Decode(char const *ptr, uint64_t &value) noexcept
+{
+    value = 0;
+    for (uint32_t shift = 0;; shift += 7) {
+        auto byte = static_cast<uint8_t>(*ptr++);
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return ptr;
+        }
+    }
+}
+
+inline char const *Skip(char const *ptr) noexcept
+{
+    while (static_cast<uint8_t>(*ptr++) & 0x80) {
+    }
+    return ptr;
+}
+
+// Checked versions for data read from files: they never read at or past end and
+// throw on overruns and on varints longer than MAX_SIZE bytes.
+inline char const *Decode(char const *ptr, char const *end, uint64_t &value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 7 * MAX_SIZE; shift += 7) {
+        if (ptr == end) {
+            throw std::runtime_error("DSHU v2: vertex record is out of file bounds");
+        }
+        auto byte = static_cast<uint8_t>(*ptr++);
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return ptr;
+        }
+    }
+    throw std::runtime_error("DSHU v2: varint is longer than 10 bytes");
+}
+
+inline char const *Skip(char const *ptr, char const *end)
+{
+    uint64_t value;
+    return Decode(ptr, end, value);
+}
+
+inline uint64_t ZigZag(int64_t value) noexcept
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t value) noexcept
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+} // namespace varint
+
+// DSHUV2.0 compact binary graph.
+//
+// Layout (little endian):
+//      Header                  64 bytes, see below
+//      uint64_t[ceil(n / B)]   block index: offset of the record of every B-th vertex,
+//                              relative to the adjacency section
+//      records                 varint degree, then the sorted neighbours:
+//                              varint zigzag(first - v), varint deltas to the previous one
+//      int64_t[2 * n]          optional coordinates section, (x, y) of every vertex
+struct DshuV2 {
+    static std::string_view constexpr MAGIC_VER_2_0 = "DSHUV2.0";
+    static uint32_t constexpr DEFAULT_BLOCK_SIZE = 64;
+
+    enum Flags : uint32_t {
+        HAS_COORDINATES = 1u << 0,
+    };
+
+    struct Header {
+        char magic[8];
+        uint64_t numVertices;
+        uint64_t numEdges;
+        uint64_t adjacencyOffset;
+        uint64_t adjacencySize;
+        uint64_t coordinatesOffset;
+        uint32_t blockSize;
+        uint32_t flags;
+        uint32_t reserved;
+        uint32_t checksum; // CRC-32 of all preceding header bytes
+    };
+    static_assert(sizeof(Header) == 64);
+
+    using Coordinate = std::pair<int64_t, int64_t>;
+
+    static bool IsDshuV2(std::string_view data) noexcept
+    {
+        return data.starts_with(MAGIC_VER_2_0);
+    }
+
+    static uint32_t Checksum(Header const& header) noexcept;
+};
+
+// Zero-copy view of a DSHUV2.0 file. Random access decodes at most one block.
+class DshuV2Graph {
+public:
+    class NeighbourIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = uint32_t;
+
+        NeighbourIterator() = default;
+        NeighbourIterator(char const *ptr, char const *end, uint64_t remaining, uint64_t v)
+            : mPtr(ptr)
+            , mEnd(end)
+            , mRemaining(remaining)
+        {
+            if (mRemaining) {
+                uint64_t delta;
+                mPtr = varint::Decode(mPtr, mEnd, delta);
+                mValue = static_cast<uint32_t>(int64_t(v) + varint::UnZigZag(delta));
+            }
+        }
+
+        uint32_t operator*() const noexcept { return mValue; }
+
+        NeighbourIterator& operator++()
+        {
+            if (--mRemaining) {
+                uint64_t delta;
+                mPtr = varint::Decode(mPtr, mEnd, delta);
+                mValue += static_cast<uint32_t>(delta);
+            }
+            return *this;
+        }
+
+        NeighbourIterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        // iterators of one range differ only by the number of remaining neighbours
+        bool operator==(NeighbourIterator const& other) const noexcept
+        {
+            return mRemaining == other.mRemaining;
+        }
+
+        char const *Position() const noexcept { return mPtr; }
+
+    private:
+        char const *mPtr { nullptr };
+        char const *mEnd { nullptr };
+        uint64_t mRemaining { 0 };
+        uint32_t mValue { 0 };
+    };
+
+    struct NeighbourRange {
+        NeighbourIterator first;
+        NeighbourIterator last;
+
+        NeighbourIterator begin() const noexcept { return first; }
+        NeighbourIterator end() const noexcept { return last; }
+    };
+
+    explicit DshuV2Graph(MappedFile file);
+
+    uint64_t NumVertices() const noexcept { return mHeader.numVertices; }
+    uint64_t NumEdges() const noexcept { return mHeader.numEdges; }
+    uint32_t BlockSize() const noexcept { return mHeader.blockSize; }
+
+    bool HasCoordinates() const noexcept { return mHeader.flags & DshuV2::HAS_COORDINATES; }
+    DshuV2::Coordinate Coordinates(uint64_t v) const noexcept;
+
+    uint64_t Degree(uint64_t v) const
+    {
+        uint64_t degree;
+        varint::Decode(Record(v), AdjacencyEnd(), degree);
+        return degree;
+    }
+
+    NeighbourRange Neighbours(uint64_t v) const
+    {
+        uint64_t degree;
+        char const *ptr = varint::Decode(Record(v), AdjacencyEnd(), degree);
+        return {NeighbourIterator(ptr, AdjacencyEnd(), degree, v), NeighbourIterator()};
+    }
+
+    // Sequential decoding of all records, f(v, NeighbourRange).
+    template <typename Func>
+    void ForEachVertex(Func&& f) const
+    {
+        char const *ptr = mAdjacency;
+        for (uint64_t v = 0; v < NumVertices(); ++v) {
+            auto [range, next] = Decode(ptr, v);
+            f(v, range);
+            ptr = next;
+        }
+    }
+
+private:
+    std::pair<NeighbourRange, char const *> Decode(char const *record, uint64_t v) const
+    {
+        uint64_t degree;
+        char const *ptr = varint::Decode(record, AdjacencyEnd(), degree);
+
+        NeighbourIterator first(ptr, AdjacencyEnd(), degree, v);
+        char const *next = first.Position();
+        for (uint64_t i = 1; i < degree; ++i) {
+            next = varint::Skip(next, AdjacencyEnd());
+        }
+        return {{first, NeighbourIterator()}, next};
+    }
+
+    // records are only decoded up to here
+    char const *AdjacencyEnd() const noexcept
+    {
+        return mAdjacency + mHeader.adjacencySize;
+    }
+
+    char const *Record(uint64_t v) const;
+
+    MappedFile mFile;
+    DshuV2::Header mHeader;
+
+    char const *mIndex { nullptr };
+    char const *mAdjacency { nullptr };
+};
+
+// Streaming DSHUV2.0 writer: vertices are appended in id order, then (optionally)
+// their coordinates. The block index and the header are patched in Finish().
+class DshuV2Writer {
+public:
+    explicit DshuV2Writer(
+        std::filesystem::path const& path, uint64_t numVertices,
+        uint32_t blockSize = DshuV2::DEFAULT_BLOCK_SIZE
+    );
+
+    // Neighbours are sorted, deduplicated and stripped of self-loops in place.
+    void AddVertex(std::span<uint32_t> neighbours);
+    void AddCoordinates(int64_t x, int64_t y);
+
+    void Finish();
+
+private:
+    void Flush();
+
+    std::ofstream mStream;
+    std::vector<char> mBuffer;
+
+    DshuV2::Header mHeader;
+    std::vector<uint64_t> mIndex;
+
+    uint64_t mNumAdded { 0 };
+    uint64_t mNumCoordinates { 0 };
+    uint64_t mDegreeSum { 0 };
+};
+} // namespace utils
@@ -0,0 +1,117 @@
+#include "mapped_file.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace utils {
+MappedFile::MappedFile(std::filesystem::path const& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Unable to open file for reading: " + path.string());
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) == -1) {
+        ::close(fd);
+        throw std::runtime_error("Unable to stat file: " + path.string());
+    }
+
+    mSize = static_cast<size_t>(st.st_size);
+    Map(fd, path, false);
+}
+
+MappedFile MappedFile::Create(std::filesystem::path const& path, size_t size)
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        throw std::runtime_error("Unable to open file for writing: " + path.string());
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+        ::close(fd);
+        throw std::runtime_error("Unable to resize file: " + path.string());
+    }
+
+    MappedFile file;
+    file.mSize = size;
+    file.Map(fd, path, true);
+    return file;
+}
+
+void MappedFile::Map(int fd, std::filesystem::path const& path, bool writable)
+{
+    if (mSize == 0) {
+        ::close(fd);
+        return;
+    }
+
+    int const prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *ptr = ::mmap(nullptr, mSize, prot, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (ptr == MAP_FAILED) {
+        mSize = 0;
+        throw std::runtime_error("Unable to map file: " + path.string());
+    }
+
+    if (!writable) {
+        ::madvise(ptr, mSize, MADV_SEQUENTIAL);
+    }
+    mData = static_cast<char const *>(ptr);
+    mWritable = writable;
+}
+
+MappedFile::~MappedFile()
+{
+    Release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mData(std::exchange(other.mData, nullptr))
+    , mSize(std::exchange(other.mSize, 0))
+    , mWritable(std::exchange(other.mWritable, false))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        Release();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mWritable = std::exchange(other.mWritable, false);
+    }
+    return *this;
+}
+
+void MappedFile::Release() noexcept
+{
+    if (mData) {
+        ::munmap(const_cast<char *>(mData), mSize);
+    }
+    mData = nullptr;
+    mSize = 0;
+    mWritable = false;
+}
+
+std::string ReadAll(std::istream &in)
+{
+    static size_t constexpr CHUNK_SIZE = 1 << 20;
+
+    std::string result;
+    size_t size = 0;
+    while (in) {
+        result.resize(size + CHUNK_SIZE);
+        in.read(result.data() + size, CHUNK_SIZE);
+        size += static_cast<size_t>(in.gcount());
+    }
+    result.resize(size);
+    return result;
+}
+} // namespace utils
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string_view>
+#include <filesystem>
+#include <istream>
+#include <cstddef>
+#include <string>
+
+namespace utils {
+// Memory mapping of a whole file: read-only for existing files,
+// writable for files created with a known size.
+class MappedFile {
+public:
+    explicit MappedFile(std::filesystem::path const& path);
+
+    // Creates (or truncates) the file, resizes it to `size` bytes and maps it for writing.
+    static MappedFile Create(std::filesystem::path const& path, size_t size);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    char const *Data() const noexcept { return mData; }
+    char *MutableData() const noexcept { return mWritable ? const_cast<char *>(mData) : nullptr; }
+    size_t Size() const noexcept { return mSize; }
+
+    std::string_view View() const noexcept
+    {
+        return {mData, mSize};
+    }
+
+private:
+    MappedFile() = default;
+
+    void Map(int fd, std::filesystem::path const& path, bool writable);
+    void Release() noexcept;
+
+    char const *mData { nullptr };
+    size_t mSize { 0 };
+    bool mWritable { false };
+};
+
+// Reads the whole stream in large chunks (used for stdin, which can't be mapped).
+std::string ReadAll(std::istream &in);
+} // namespace utils
@@ -1,5 +1,7 @@
 #include "generator.h"
 
+#include <dshu_v2.h>
+
 #include <ieee754.h>
 typedef long double fpt80;
 
@@ -250,4 +252,25 @@ void Generator::ToSVG(std::ostream &svg) const
         map.map(segment, R"(stroke:rgb(0, 0, 0);stroke-width:1)");
     }
 }
+
+void Generator::ToDshu(std::filesystem::path const& path) const
+{
+    utils::DshuV2Writer writer(path, boost::num_vertices(mGraph));
+
+    std::vector<uint32_t> neighbours;
+    for (auto v: boost::make_iterator_range(boost::vertices(mGraph))) {
+        neighbours.clear();
+        for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, mGraph))) {
+            neighbours.emplace_back(u);
+        }
+        writer.AddVertex(neighbours);
+    }
+
+    auto vertexCoord = boost::get(&VertexProperty::coord, mGraph);
+    for (auto v: boost::make_iterator_range(boost::vertices(mGraph))) {
+        writer.AddCoordinates(vertexCoord[v].x, vertexCoord[v].y);
+    }
+
+    writer.Finish();
+}
 } // namespace generator
\ No newline at end of file
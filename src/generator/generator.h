@@ -14,6 +14,8 @@
 
 #include <random.h>
 
+#include <filesystem>
+
 #include "parameters.h"
 
 struct Point {
@@ -93,6 +95,7 @@ public:
     Graph const& GetGraph() const;
 
     void ToSVG(std::ostream &svg) const;
+    void ToDshu(std::filesystem::path const& path) const;
 
 private:
     void GenerateRandomPoints(Points &points);
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <ostream>
 #include <iomanip>
+#include <thread>
 #include <vector>
 
 #include <dimacs_coloring_io.h>
@@ -39,7 +40,9 @@ bool ProcessCommandLine(int32_t argc, char **argv, generator::Parameters &params
         ("remove-prob,r", po::value<double>(&params.removeProbability)->default_value(0.5), 
             "Edge removal probability [0.0;1.0].")
         ("export-svg", po::value<fs::path>()->composing(), 
-            "SVG output file path.");
+            "SVG output file path.")
+        ("export-dshu", po::value<fs::path>()->composing(), 
+            "DSHUV2.0 output file path (with vertex coordinates).");
 
     po::options_description hugeGraphMode("Huge graph mode options");
     hugeGraphMode.add_options()
@@ -48,7 +51,9 @@ bool ProcessCommandLine(int32_t argc, char **argv, generator::Parameters &params
         ("width,w", po::value<uint32_t>(&params.width)->required(), 
             "Image width.")
         ("height,h", po::value<uint32_t>(&params.height)->required(), 
-            "Image height.");
+            "Image height.")
+        ("threads,j", po::value<size_t>(&params.numThreads)->default_value(std::max(1u, std::thread::hardware_concurrency())),
+            "Number of writer threads.");
 
     po::variables_map vm;
     try {
@@ -88,6 +93,10 @@ bool ProcessCommandLine(int32_t argc, char **argv, generator::Parameters &params
             params.svgPath = vm["export-svg"].as<fs::path>();
         }
 
+        if (vm.contains("export-dshu")) {
+            params.dshuPath = vm["export-dshu"].as<fs::path>();
+        }
+
         try {
             po::notify(vmDefault);
         } catch(std::exception& e) {
@@ -127,7 +136,7 @@ static void ConnectedComponents(std::ostream &out, generator::Generator::Graph c
         ncomps = std::max(ncomps, boost::get(&VertexProperty::component, g, v) + 1);
     }
 
-    out << "c STATS: Connected components = " << ncomps << std::endl;
+    out << "c STATS: Connected components = " << ncomps << '\n';
 }
 
 static void FaceCounts(std::ostream &out, generator::Generator::Graph const& g)
@@ -147,7 +156,7 @@ static void FaceCounts(std::ostream &out, generator::Generator::Graph const& g)
     );
 
     if (!isPlanar) {
-        out << "c STATS: The graph is not planar :D" << std::endl;
+        out << "c STATS: The graph is not planar :D\n";
         return;
     }
 
@@ -155,7 +164,7 @@ static void FaceCounts(std::ostream &out, generator::Generator::Graph const& g)
     detail::FaceCounter visitor(faceStats);
     boost::planar_face_traversal(g, &embedding[0], visitor, boost::get(&EdgeProperty::index, g));
 
-    out << "c STATS: Face vertex count distribution:" << std::endl;
+    out << "c STATS: Face vertex count distribution:\n";
     for (auto const& [vertCount, faceCount] : faceStats) {
         out << "c        " 
             << std::setw(4) << vertCount << " verts: "
@@ -163,7 +172,7 @@ static void FaceCounts(std::ostream &out, generator::Generator::Graph const& g)
         if (faceCount != 1) [[likely]] {
             out << 's';
         }
-        out << std::endl;
+        out << '\n';
     }
 }
 } // namespace user_comments
@@ -176,7 +185,7 @@ int32_t main(int32_t argc, char **argv)
     }
 
     if (!params.isDefaultMode) {
-        generator::HugeGraphGenerator gen(params.resultPath, params.width, params.height);
+        generator::HugeGraphGenerator gen(params.resultPath, params.width, params.height, params.numThreads);
         gen.Generate();
         return EXIT_SUCCESS;
     }
@@ -205,5 +214,11 @@ int32_t main(int32_t argc, char **argv)
         std::cout << "\033[38;05;46m" << fs::canonical(*params.svgPath) << "\033[0m" << std::endl;
     }
 
+    if (params.dshuPath) {
+        gen.ToDshu(*params.dshuPath);
+        std::cerr << "DSHU graph is written to ";
+        std::cerr << "\033[38;05;46m" << fs::canonical(*params.dshuPath) << "\033[0m" << std::endl;
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
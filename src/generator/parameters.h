@@ -15,6 +15,7 @@ struct Parameters {
     double removeProbability { 0.5 };
 
     std::optional<std::filesystem::path> svgPath { std::nullopt };
+    std::optional<std::filesystem::path> dshuPath { std::nullopt };
 
     // params for huge graph mode
 
@@ -22,5 +23,7 @@ struct Parameters {
     
     uint32_t width;
     uint32_t height; 
+
+    size_t numThreads { 1 };
 };
 } // namespace generator
\ No newline at end of file
@@ -1,75 +1,138 @@
 #include "special.h"
 #include "bytes_conversion.h"
+#include "mapped_file.h"
 
 #include <iostream>
 #include <tqdm.hpp>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
 
 namespace generator {
 const char *HugeGraphGenerator::MAGIC_VER_1_0 = "DSHUV1.0";
 
 void HugeGraphGenerator::Generate()
 {
-    mStream.write(MAGIC_VER_1_0, MAGIC_SIZE);
     std::cerr << "Graph format : " << MAGIC_VER_1_0 << std::endl;
-    
+
     uint32_t const numVertices = mWidth * mHeight;
 
-    // assumption: 
+    // assumption:
     //      (w-2)*(h-2) inside  - 8 edges
     //      4           corners - 3 edges
     //      2*(w+h-4)   border  - 5 edges
-    uint64_t const numEdges = 8 * (mWidth - 2) * (mHeight - 2)
+    // every edge is counted from both of its endpoints
+    uint64_t const numEdges = (8 * uint64_t(mWidth - 2) * (mHeight - 2)
                             + 3 * 4
-                            + 5 * 2 * (mWidth + mHeight - 4);
-    
-    Write(numVertices, numEdges);
+                            + 5 * 2 * uint64_t(mWidth + mHeight - 4)) / 2;
+
     std::cerr << "Num vertices : " << numVertices << std::endl;
     std::cerr << "Num edges    : " << numEdges << std::endl;
-    
-    uint64_t const resultSizeInBytes = mMetadataSectionStart
-                                     + (sizeof(uint8_t) + 8 * sizeof(uint32_t)) * (mWidth - 2) * (mHeight - 2)
-                                     + (sizeof(uint8_t) + 3 * sizeof(uint32_t)) * 4
-                                     + (sizeof(uint8_t) + 5 * sizeof(uint32_t)) * 2 * (mWidth + mHeight - 4);
-    std::cerr << "Result size  : " << utils::BytesToHumanReadable(resultSizeInBytes) << std::endl; 
-
-    uint64_t const zero = 0;
-    for (uint32_t i = 0; i < numVertices; ++i) {
-        Write(zero);
+
+    uint64_t const resultSizeInBytes = mMetadataSectionStart + ColumnOffset(mWidth - 1) + ColumnSize(mWidth - 1);
+    std::cerr << "Result size  : " << utils::BytesToHumanReadable(resultSizeInBytes) << std::endl;
+
+    // every offset is known up front, so the file is pre-sized and
+    // column bands are filled in parallel through a shared mapping
+    auto file = utils::MappedFile::Create(mPath, resultSizeInBytes);
+    char *data = file.MutableData();
+
+    std::memcpy(data, MAGIC_VER_1_0, MAGIC_SIZE);
+    Store(data + MAGIC_SIZE, numVertices, numEdges);
+
+    std::atomic<uint32_t> columnsDone = 0;
+    auto worker = [this, data, &columnsDone](uint32_t first, uint32_t last) {
+        for (uint32_t x = first; x < last; ++x) {
+            WriteColumn(data, x);
+            columnsDone.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    size_t const numBands = std::min<size_t>(mNumThreads, mWidth);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numBands; ++i) {
+        threads.emplace_back(worker, i * mWidth / numBands, (i + 1) * mWidth / numBands);
     }
 
     auto tqdm = tq::trange(mWidth);
+    for (uint32_t reported = 0; reported < mWidth;) {
+        for (uint32_t done = columnsDone.load(std::memory_order_relaxed); reported < done; ++reported) {
+            tqdm.update();
+        }
+        if (reported < mWidth) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
 
-    WriteVertexMetadataOffset(GetV(0, 0));
-    Write(static_cast<uint8_t>(3),
-        GetV(0, 1),
-        GetV(1, 0),
-        GetV(1, 1)
-    );
-
-    for (uint32_t j = 1; j < mHeight - 1; ++j) {
-        WriteVertexMetadataOffset(GetV(0, j));
-        Write(static_cast<uint8_t>(8), 
-            GetV(0, j - 1),
-            GetV(1, j - 1),
-            GetV(1, j),
-            GetV(1, j + 1), 
-            GetV(0, j + 1)
-        );
+    for (auto &t: threads) {
+        t.join();
     }
 
-    WriteVertexMetadataOffset(GetV(0, mHeight - 1));
-    Write(static_cast<uint8_t>(3),
-        GetV(0, mHeight - 2),
-        GetV(1, mHeight - 1),
-        GetV(1, mHeight - 2)
-    );
-    
-    tqdm.update();
+    std::cerr << '\n';
+}
+
+void HugeGraphGenerator::WriteColumn(char *data, uint32_t x) const
+{
+    char *record = data + mMetadataSectionStart + ColumnOffset(x);
+
+    auto writeVertex = [this, data, x, &record](uint32_t y, auto... neighbours) {
+        uint64_t const offset = record - data;
+        Store(data + mVertexSectionStart + uint64_t(GetV(x, y)) * sizeof(uint64_t), offset);
+        record = Store(record, static_cast<uint8_t>(sizeof...(neighbours)), neighbours...);
+    };
+
+    uint32_t const w = mWidth;
+    uint32_t const h = mHeight;
+
+    if (x == 0) {
+        writeVertex(0,
+            GetV(0, 1),
+            GetV(1, 0),
+            GetV(1, 1)
+        );
+
+        for (uint32_t j = 1; j < h - 1; ++j) {
+            writeVertex(j,
+                GetV(0, j - 1),
+                GetV(1, j - 1),
+                GetV(1, j),
+                GetV(1, j + 1),
+                GetV(0, j + 1)
+            );
+        }
 
-    for (uint32_t i = 1; i < mWidth - 1; ++i) {
+        writeVertex(h - 1,
+            GetV(0, h - 2),
+            GetV(1, h - 1),
+            GetV(1, h - 2)
+        );
+    } else if (x == w - 1) {
+        writeVertex(0,
+            GetV(w - 2, 0),
+            GetV(w - 2, 1),
+            GetV(w - 1, 1)
+        );
 
-        WriteVertexMetadataOffset(GetV(i, 0));
-        Write(static_cast<uint8_t>(5),
+        for (uint32_t j = 1; j < h - 1; ++j) {
+            writeVertex(j,
+                GetV(w - 1, j - 1),
+                GetV(w - 2, j - 1),
+                GetV(w - 2, j),
+                GetV(w - 2, j + 1),
+                GetV(w - 1, j + 1)
+            );
+        }
+
+        writeVertex(h - 1,
+            GetV(w - 2, h - 1),
+            GetV(w - 2, h - 2),
+            GetV(w - 1, h - 2)
+        );
+    } else {
+        uint32_t const i = x;
+
+        writeVertex(0,
             GetV(i - 1, 0),
             GetV(i - 1, 1),
             GetV(i, 1),
@@ -77,9 +140,8 @@ void HugeGraphGenerator::Generate()
             GetV(i + 1, 0)
         );
 
-        for (uint32_t j = 1; j < mHeight - 1; ++j) {
-            WriteVertexMetadataOffset(GetV(i, j));
-            Write(static_cast<uint8_t>(8),
+        for (uint32_t j = 1; j < h - 1; ++j) {
+            writeVertex(j,
                 GetV(i - 1, j),
                 GetV(i - 1, j + 1),
                 GetV(i, j + 1),
@@ -91,44 +153,13 @@ void HugeGraphGenerator::Generate()
             );
         }
 
-        WriteVertexMetadataOffset(GetV(i, mHeight - 1));
-        Write(static_cast<uint8_t>(5),
-            GetV(i - 1, mHeight - 1),
-            GetV(i - 1, mHeight - 2),
-            GetV(i, mHeight - 2),
-            GetV(i + 1, mHeight - 2),
-            GetV(i + 1, mHeight - 1)
-        );
-        tqdm.update();
-    }
-
-
-    WriteVertexMetadataOffset(GetV(mWidth - 1, 0));
-    Write(static_cast<uint8_t>(3),
-        GetV(mWidth - 2, 0),
-        GetV(mWidth - 2, 1),
-        GetV(mWidth - 1, 1)
-    );
-
-    for (uint32_t j = 1; j < mHeight - 1; ++j) {
-        WriteVertexMetadataOffset(GetV(mWidth - 1, j));
-        Write(static_cast<uint8_t>(5), 
-            GetV(mWidth - 1, j - 1),
-            GetV(mWidth - 2, j - 1),
-            GetV(mWidth - 2, j),
-            GetV(mWidth - 2, j + 1),
-            GetV(mWidth - 1, j + 1)
+        writeVertex(h - 1,
+            GetV(i - 1, h - 1),
+            GetV(i - 1, h - 2),
+            GetV(i, h - 2),
+            GetV(i + 1, h - 2),
+            GetV(i + 1, h - 1)
         );
     }
-
-    WriteVertexMetadataOffset(GetV(mWidth - 1, mHeight - 1));
-    Write(static_cast<uint8_t>(3),
-        GetV(mWidth - 2, mHeight - 1),
-        GetV(mWidth - 2, mHeight - 2),
-        GetV(mWidth - 1, mHeight - 2)
-    );
-
-    tqdm.update();
-    std::cerr << '\n';
 }
-} // namespace generator
\ No newline at end of file
+} // namespace generator
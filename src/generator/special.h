@@ -4,22 +4,25 @@
 #include <filesystem>
 #include <stdexcept>
 #include <iostream>
-#include <fstream>
+#include <cstring>
 #include <limits>
-#include <ios>
 
 #include <bytes_conversion.h>
 
 namespace generator {
 class HugeGraphGenerator {
 public:
-    explicit HugeGraphGenerator(std::filesystem::path const& path, uint32_t width, uint32_t height)
-        : mStream(path, std::ios::binary)
+    explicit HugeGraphGenerator(std::filesystem::path const& path, uint32_t width, uint32_t height, size_t numThreads = 1)
+        : mPath(path)
         , mWidth(width)
         , mHeight(height)
+        , mNumThreads(std::max<size_t>(numThreads, 1))
         , mVertexSectionStart(8 * sizeof(char) + sizeof(uint32_t) + sizeof(uint64_t))
-        , mMetadataSectionStart(mVertexSectionStart + mHeight * mHeight * sizeof(uint64_t))
+        , mMetadataSectionStart(mVertexSectionStart + uint64_t(mWidth) * mHeight * sizeof(uint64_t))
     {
+        if (mWidth < 2 || mHeight < 2) {
+            throw std::invalid_argument("width and height must be at least 2");
+        }
         if (std::numeric_limits<uint32_t>::max() / mWidth < mHeight) {
             throw std::invalid_argument("uint32_t overflow in (width x height)");
         }
@@ -28,44 +31,67 @@ public:
     void Generate();
 
 private:
+    // Writes the offset table entries and vertex records of column x.
+    void WriteColumn(char *data, uint32_t x) const;
+
     template <typename... T>
-    void Write(T const&... value)
+    static char *Store(char *ptr, T const&... value)
+    {
+        ((std::memcpy(ptr, &value, sizeof(std::decay_t<T>)), ptr += sizeof(std::decay_t<T>)), ...);
+        return ptr;
+    }
+
+    static constexpr uint64_t RecordSize(uint64_t degree)
+    {
+        return sizeof(uint8_t) + degree * sizeof(uint32_t);
+    }
+
+    // Record sizes are known in closed form: the first and the last columns hold
+    // 2 corners (3 neighbours) and border vertices (5 neighbours), inner columns
+    // hold 2 border vertices and inner vertices (8 neighbours).
+    constexpr uint64_t ColumnSize(uint32_t x) const
     {
-        (mStream.write(reinterpret_cast<const char *>(&value), sizeof(std::decay_t<T>)), ...);
+        if (x == 0 || x == mWidth - 1) {
+            return 2 * RecordSize(3) + (mHeight - 2) * RecordSize(5);
+        }
+        return 2 * RecordSize(5) + (mHeight - 2) * RecordSize(8);
     }
 
-    void WriteVertexMetadataOffset(uint32_t v)
+    // Offset of column x records from the start of metadata section.
+    constexpr uint64_t ColumnOffset(uint32_t x) const
     {
-        uint64_t const pos = mStream.tellp();
-        mStream.seekp(mVertexSectionStart + v * sizeof(uint64_t), std::ios_base::beg);
-        Write(pos);
-        mStream.seekp(pos, std::ios::beg);
+        if (x == 0) {
+            return 0;
+        }
+        return ColumnSize(0) + (x - 1) * ColumnSize(1);
     }
 
     constexpr uint32_t GetV(uint32_t x, uint32_t y) const
     {
-        return x * mWidth + y;
+        return x * mHeight + y;
     }
 
     constexpr uint32_t GetX(uint32_t v) const
     {
-        return v / mWidth;
+        return v / mHeight;
     }
 
     constexpr uint32_t GetY(uint32_t v) const
     {
-        return v / mHeight;
+        return v % mHeight;
     }
 
     static size_t constexpr MAGIC_SIZE = 8;
     static const char *MAGIC_VER_1_0;
 
-    std::ofstream mStream;
-    
+    std::filesystem::path const mPath;
+
     uint32_t const mWidth;
     uint32_t const mHeight;
 
+    size_t const mNumThreads;
+
     uint64_t const mVertexSectionStart;
     uint64_t const mMetadataSectionStart;
 };
-} // namespace generator
\ No newline at end of file
+} // namespace generator
@@ -0,0 +1,168 @@
+#include <boost/program_options.hpp>
+
+#include <filesystem>
+#include <stdexcept>
+#include <iostream>
+#include <optional>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <adjacency_arrays.h>
+#include <dimacs_parser.h>
+#include <mapped_file.h>
+#include <dshu_graph.h>
+#include <dshu_v2.h>
+
+#include "writers.h"
+
+namespace po = boost::program_options;
+namespace fs = std::filesystem;
+
+enum class Format {
+    DIMACS,
+    DSHU_V1,
+    DSHU_V2,
+};
+
+std::istream &operator>>(std::istream& in, Format& format)
+{
+    std::string token;
+    in >> token;
+
+    for (auto &ch: token) {
+        ch = std::tolower(ch);
+    }
+
+    if (token == "dimacs") {
+        format = Format::DIMACS;
+    } else if (token == "dshu1") {
+        format = Format::DSHU_V1;
+    } else if (token == "dshu2") {
+        format = Format::DSHU_V2;
+    } else {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+struct Parameters {
+    std::optional<fs::path> inputPath { std::nullopt };
+    std::optional<fs::path> outputPath { std::nullopt };
+    Format format { Format::DSHU_V2 };
+    uint32_t blockSize { utils::DshuV2::DEFAULT_BLOCK_SIZE };
+    size_t numThreads { std::max(1u, std::thread::hardware_concurrency()) };
+};
+
+bool ProcessCommandLine(int32_t argc, char **argv, Parameters &params)
+{
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "Produce help message.")
+        ("input,i", po::value<fs::path>()->composing(),
+            "Input graph: DIMACS, DSHUV1.0 or DSHUV2.0 (detected by magic). DIMACS is read from stdin by default.")
+        ("output,o", po::value<fs::path>()->composing(),
+            "Output path. DIMACS is written to stdout by default.")
+        ("format,f", po::value<Format>(&params.format),
+            "Output format. Possible values: dimacs, dshu1, dshu2 (default).")
+        ("block-size,b", po::value<uint32_t>(&params.blockSize),
+            "Vertices per block index entry in dshu2 output.")
+        ("threads,j", po::value<size_t>(&params.numThreads),
+            "Number of DIMACS parser threads (default: all cores).");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch(std::exception& e) {
+        std::cerr << "\033[31m" << "Error: " << e.what() << "\033[0m" << std::endl;
+        return false;
+    }
+
+    if (vm.contains("help")) {
+        std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
+        std::cout << desc << std::endl;
+        return false;
+    }
+
+    if (vm.contains("input")) {
+        params.inputPath = vm["input"].as<fs::path>();
+    }
+
+    if (vm.contains("output")) {
+        params.outputPath = vm["output"].as<fs::path>();
+    }
+
+    if (params.format != Format::DIMACS && !params.outputPath) {
+        std::cerr << "\033[31m" << "Error: binary output requires --output" << "\033[0m" << std::endl;
+        return false;
+    }
+
+    // the input stays mapped while the output is written, so it must not be the same file
+    std::error_code error;
+    if (params.inputPath && params.outputPath && fs::equivalent(*params.inputPath, *params.outputPath, error)) {
+        std::cerr << "\033[31m" << "Error: --output must differ from --input" << "\033[0m" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename Source>
+void Convert(Source const& src, Parameters const& params)
+{
+    switch (params.format) {
+    case Format::DIMACS:
+        if (params.outputPath) {
+            std::ofstream out(*params.outputPath, std::ios::binary);
+            if (!out.is_open()) {
+                throw std::runtime_error("Unable to open file for writing: " + params.outputPath->string());
+            }
+            graphconv::WriteDimacs(src, out);
+        } else {
+            graphconv::WriteDimacs(src, std::cout);
+        }
+        break;
+    case Format::DSHU_V1:
+        graphconv::WriteDshuV1(src, *params.outputPath);
+        break;
+    case Format::DSHU_V2:
+        graphconv::WriteDshuV2(src, *params.outputPath, params.blockSize);
+        break;
+    }
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    Parameters params;
+    if (!ProcessCommandLine(argc, argv, params)) {
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::optional<utils::MappedFile> file;
+        std::string input;
+        if (params.inputPath) {
+            file.emplace(*params.inputPath);
+        } else {
+            input = utils::ReadAll(std::cin);
+        }
+
+        // binary inputs are converted straight from the mapping, record by record
+        if (file && utils::DshuGraph::IsDshu(file->View())) {
+            Convert(utils::DshuGraph(std::move(*file)), params);
+        } else if (file && utils::DshuV2::IsDshuV2(file->View())) {
+            Convert(utils::DshuV2Graph(std::move(*file)), params);
+        } else {
+            // DIMACS edges come in no particular order, so they are grouped in memory first
+            auto problem = utils::ParseDimacs(file ? file->View() : std::string_view(input), params.numThreads);
+            Convert(utils::AdjacencyArrays::FromEdges(problem.numVertices, problem.edges), params);
+        }
+    } catch(std::exception& e) {
+        std::cerr << "\033[31m" << "Error: " << e.what() << "\033[0m" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <filesystem>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <dimacs_writer.h>
+#include <mapped_file.h>
+#include <dshu_graph.h>
+#include <dshu_v2.h>
+
+// Writers take any adjacency source with NumVertices() and
+// ForEachVertex(f(v, neighbours)): DshuGraph, DshuV2Graph or AdjacencyArrays.
+namespace graphconv {
+template <typename Source>
+uint64_t CountEdges(Source const& src)
+{
+    uint64_t numEdges = 0;
+    src.ForEachVertex([&numEdges](uint64_t v, auto neighbours) {
+        for (uint32_t u: neighbours) {
+            numEdges += (v < u);
+        }
+    });
+    return numEdges;
+}
+
+template <typename Source>
+void WriteDimacs(Source const& src, std::ostream &out)
+{
+    static size_t constexpr BUFFER_SIZE = 1 << 20;
+
+    std::string buffer(BUFFER_SIZE + utils::DIMACS_MAX_EDGE_LINE_SIZE, '\0');
+    char *ptr = buffer.data();
+
+    auto flush = [&out, &buffer, &ptr]() {
+        out.write(buffer.data(), ptr - buffer.data());
+        ptr = buffer.data();
+    };
+
+    // Format: p edge <vertices> <edges>
+    out << "p edge " << src.NumVertices() << " " << CountEdges(src) << "\n";
+
+    // Format: e <vertex1> <vertex2>
+    src.ForEachVertex([&](uint64_t v, auto neighbours) {
+        for (uint32_t u: neighbours) {
+            if (v >= u) {
+                continue;
+            }
+            ptr = utils::FormatDimacsEdge(ptr, v, u);
+            if (ptr >= buffer.data() + BUFFER_SIZE) {
+                flush();
+            }
+        }
+    });
+    flush();
+}
+
+template <typename Source>
+void WriteDshuV1(Source const& src, std::filesystem::path const& path)
+{
+    using Dshu = utils::DshuGraph;
+
+    if (src.NumVertices() > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("DSHU v1 holds at most 2^32-1 vertices");
+    }
+    uint32_t const numVertices = src.NumVertices();
+
+    // first pass: record sizes, so every offset is known before writing
+    std::vector<uint8_t> degrees(numVertices);
+    uint64_t numEdges = 0;
+    uint64_t size = Dshu::HEADER_SIZE + uint64_t(numVertices) * sizeof(uint64_t);
+
+    src.ForEachVertex([&](uint64_t v, auto neighbours) {
+        uint64_t degree = 0;
+        for (uint32_t u: neighbours) {
+            ++degree;
+            numEdges += (v < u);
+        }
+        if (degree > std::numeric_limits<uint8_t>::max()) {
+            throw std::invalid_argument("DSHU v1 holds degrees up to 255");
+        }
+        degrees[v] = degree;
+        size += sizeof(uint8_t) + degree * sizeof(uint32_t);
+    });
+
+    auto file = utils::MappedFile::Create(path, size);
+    char *data = file.MutableData();
+
+    auto store = [](char *ptr, auto value) {
+        std::memcpy(ptr, &value, sizeof(value));
+        return ptr + sizeof(value);
+    };
+
+    char *ptr = data;
+    std::memcpy(ptr, Dshu::MAGIC_VER_1_0.data(), Dshu::MAGIC_SIZE);
+    ptr = store(ptr + Dshu::MAGIC_SIZE, numVertices);
+    ptr = store(ptr, numEdges);
+
+    uint64_t offset = Dshu::HEADER_SIZE + uint64_t(numVertices) * sizeof(uint64_t);
+    for (uint32_t v = 0; v < numVertices; ++v) {
+        ptr = store(ptr, offset);
+        offset += sizeof(uint8_t) + degrees[v] * sizeof(uint32_t);
+    }
+
+    // second pass: records
+    src.ForEachVertex([&](uint64_t v, auto neighbours) {
+        ptr = store(ptr, degrees[v]);
+        for (uint32_t u: neighbours) {
+            ptr = store(ptr, u);
+        }
+    });
+}
+
+template <typename Source>
+void WriteDshuV2(Source const& src, std::filesystem::path const& path, uint32_t blockSize)
+{
+    utils::DshuV2Writer writer(path, src.NumVertices(), blockSize);
+
+    std::vector<uint32_t> buffer;
+    src.ForEachVertex([&writer, &buffer](uint64_t, auto neighbours) {
+        buffer.assign(neighbours.begin(), neighbours.end());
+        writer.AddVertex(buffer);
+    });
+
+    if constexpr (requires { src.HasCoordinates(); }) {
+        if (src.HasCoordinates()) {
+            for (uint64_t v = 0; v < src.NumVertices(); ++v) {
+                auto [x, y] = src.Coordinates(v);
+                writer.AddCoordinates(x, y);
+            }
+        }
+    }
+
+    writer.Finish();
+}
+} // namespace graphconv
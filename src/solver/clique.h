@@ -1,12 +1,13 @@
 #pragma once
 
-#include <boost/graph/boyer_myrvold_planar_test.hpp>
 #include <boost/graph/planar_face_traversal.hpp>
 
 #include <unordered_map>
 #include <iostream>
 #include <vector>
 
+#include "embedding.h"
+#include "csr_bgl.h"
 #include "graph.h"
 
 namespace solver {
@@ -55,27 +56,24 @@ struct CliqueFinder : public boost::planar_face_traversal_visitor
     }
 };
 
-inline int32_t FindClique(Graph const& g)
+inline int32_t FindClique(Graph const& csr, Embedding const& embedding)
 {
-    std::vector<std::vector<Edge>> embedding(boost::num_vertices(g));
-
-    namespace P = boost::boyer_myrvold_params; 
-    bool isPlanar = boost::boyer_myrvold_planarity_test(
-        P::graph = g,
-        P::embedding = &embedding[0],
-        P::edge_index_map = boost::get(&EdgeProperty::index, g),
-        P::vertex_index_map = boost::get(&VertexProperty::index, g)
-    );
-
-    if (!isPlanar) {
-        std::cout << "[WARNING] not a planar graph" << std::endl;
-        return -1;
-    }
+    CsrBglView g(csr);
 
     int32_t answer;
     CliqueFinder visitor(answer);
-    boost::planar_face_traversal(g, &embedding[0], visitor, boost::get(&EdgeProperty::index, g));
+    boost::planar_face_traversal(g, embedding.data(), visitor, CsrEdgeIndexMap());
 
     return answer;
 }
+
+inline int32_t FindClique(Graph const& csr)
+{
+    auto embedding = PlanarEmbedding(csr);
+    if (!embedding) {
+        std::cout << "[WARNING] not a planar graph" << std::endl;
+        return -1;
+    }
+    return FindClique(csr, *embedding);
+}
 } // namespace solver
\ No newline at end of file
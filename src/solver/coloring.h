@@ -1,15 +1,13 @@
 #pragma once
 
-#include <boost/graph/adjacency_list.hpp>
-
-#include <boost/range/iterator_range.hpp>
+#include "graph.h"
 
 namespace solver {
-template <class VertexListGraph, class ColorMap>
-static bool Validate(VertexListGraph const& g, ColorMap color)
+template <class GraphType, class ColorMap>
+static bool Validate(GraphType const& g, ColorMap const& color)
 {
-    for (auto v: boost::make_iterator_range(boost::vertices(g))) {
-        for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
+    for (Vertex v = 0; v < g.NumVertices(); ++v) {
+        for (auto u: g.Neighbours(v)) {
             if (color[v] == color[u]) {
                 return false;
             }
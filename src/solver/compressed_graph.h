@@ -0,0 +1,188 @@
+#pragma once
+
+#include <stdexcept>
+#include <iterator>
+#include <cstdint>
+#include <vector>
+
+#include <dshu_v2.h>
+
+#include "graph.h"
+
+namespace solver {
+// Read-only graph with neighbour lists delta-encoded into one byte array, the
+// in-memory counterpart of DSHUV2.0 records:
+//      varint degree, varint payload size in bytes,
+//      payload: varint zigzag(first - v), varint deltas to the previous neighbour
+// Every BLOCK_SIZE-th record start is indexed, a lookup skips at most
+// BLOCK_SIZE - 1 records by their payload sizes.
+class CompressedGraph {
+public:
+    static uint32_t constexpr BLOCK_SIZE = 16;
+
+    class NeighbourIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Vertex;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Vertex;
+
+        NeighbourIterator() = default;
+        NeighbourIterator(char const *ptr, uint64_t remaining, Vertex v)
+            : mPtr(ptr)
+            , mRemaining(remaining)
+        {
+            if (mRemaining) {
+                uint64_t delta;
+                mPtr = utils::varint::Decode(mPtr, delta);
+                mValue = static_cast<Vertex>(int64_t(v) + utils::varint::UnZigZag(delta));
+            }
+        }
+
+        Vertex operator*() const noexcept { return mValue; }
+
+        NeighbourIterator& operator++() noexcept
+        {
+            if (--mRemaining) {
+                uint64_t delta;
+                mPtr = utils::varint::Decode(mPtr, delta);
+                mValue += static_cast<Vertex>(delta);
+            }
+            return *this;
+        }
+
+        NeighbourIterator operator++(int) noexcept
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        // iterators of one range differ only by the number of remaining neighbours
+        bool operator==(NeighbourIterator const& other) const noexcept
+        {
+            return mRemaining == other.mRemaining;
+        }
+
+    private:
+        char const *mPtr { nullptr };
+        uint64_t mRemaining { 0 };
+        Vertex mValue { 0 };
+    };
+
+    struct NeighbourRange {
+        NeighbourIterator first;
+        NeighbourIterator last;
+
+        NeighbourIterator begin() const noexcept { return first; }
+        NeighbourIterator end() const noexcept { return last; }
+    };
+
+    CompressedGraph() = default;
+
+    // Encodes src.ForEachVertex(f(v, neighbours)) lists, which must be sorted and
+    // free of duplicates and self-loops: CsrGraph, AdjacencyArrays, DshuV2Graph.
+    template <typename Source>
+    static CompressedGraph Encode(Source const& src);
+
+    SizeType NumVertices() const noexcept
+    {
+        return mNumVertices;
+    }
+
+    SizeType NumEdges() const noexcept
+    {
+        return mNumEdges;
+    }
+
+    SizeType Degree(Vertex v) const noexcept
+    {
+        uint64_t degree;
+        utils::varint::Decode(Record(v), degree);
+        return degree;
+    }
+
+    NeighbourRange Neighbours(Vertex v) const noexcept
+    {
+        uint64_t degree, size;
+        char const *ptr = utils::varint::Decode(Record(v), degree);
+        ptr = utils::varint::Decode(ptr, size);
+        return {NeighbourIterator(ptr, degree, v), NeighbourIterator()};
+    }
+
+    // Heap bytes held by the graph.
+    size_t MemoryUsage() const noexcept
+    {
+        return mData.capacity() * sizeof(char) + mBlockIndex.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    char const *Record(Vertex v) const noexcept
+    {
+        char const *ptr = mData.data() + mBlockIndex[v / BLOCK_SIZE];
+        for (Vertex i = v - v % BLOCK_SIZE; i < v; ++i) {
+            uint64_t size;
+            ptr = utils::varint::Skip(ptr);
+            ptr = utils::varint::Decode(ptr, size);
+            ptr += size;
+        }
+        return ptr;
+    }
+
+    std::vector<char> mData;
+    std::vector<uint64_t> mBlockIndex;
+
+    SizeType mNumVertices { 0 };
+    SizeType mNumEdges { 0 };
+};
+
+template <typename Source>
+CompressedGraph CompressedGraph::Encode(Source const& src)
+{
+    // longest varint of a 64-bit value
+    static size_t constexpr MAX_VARINT_SIZE = 10;
+
+    CompressedGraph result;
+    result.mNumVertices = src.NumVertices();
+    result.mBlockIndex.reserve((result.mNumVertices + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    uint64_t numTargets = 0;
+    std::vector<char> payload;
+    src.ForEachVertex([&result, &payload, &numTargets](uint64_t v, auto neighbours) {
+        if (v % BLOCK_SIZE == 0) {
+            result.mBlockIndex.push_back(result.mData.size());
+        }
+
+        uint64_t degree = 0;
+        int64_t prev = v;
+        bool first = true;
+        payload.clear();
+        for (uint64_t u: neighbours) {
+            if (u >= result.mNumVertices || (!first && int64_t(u) <= prev)) {
+                throw std::runtime_error("Neighbour lists must be sorted and in range");
+            }
+            uint64_t const value = first ? utils::varint::ZigZag(int64_t(u) - prev) : u - prev;
+            payload.resize(payload.size() + MAX_VARINT_SIZE);
+            char *end = utils::varint::Encode(payload.data() + payload.size() - MAX_VARINT_SIZE, value);
+            payload.resize(end - payload.data());
+
+            prev = u;
+            first = false;
+            ++degree;
+        }
+        numTargets += degree;
+
+        char header[2 * MAX_VARINT_SIZE];
+        char *end = utils::varint::Encode(header, degree);
+        end = utils::varint::Encode(end, payload.size());
+
+        result.mData.insert(result.mData.end(), header, end);
+        result.mData.insert(result.mData.end(), payload.begin(), payload.end());
+    });
+
+    result.mNumEdges = numTargets / 2;
+    result.mData.shrink_to_fit();
+    return result;
+}
+} // namespace solver
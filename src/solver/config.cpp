@@ -20,6 +20,10 @@ std::istream &operator>>(std::istream& in, Config& config)
         config = DSATUR_SEWELL;
     } else if (token == "DSATUR_PASS") {
         config = DSATUR_PASS;
+    } else if (token == "DSATUR_BUCKET") {
+        config = DSATUR_BUCKET;
+    } else if (token == "DSATUR_DARY_HEAP") {
+        config = DSATUR_DARY_HEAP;
 
     } else if (token == "BNB_DSATUR") {
         config = BNB_DSATUR;
@@ -28,6 +32,77 @@ std::istream &operator>>(std::istream& in, Config& config)
     } else if (token == "BNB_DSATUR_PASS") {
         config = BNB_DSATUR_PASS;
 
+    } else if (token == "PARALLEL_JP") {
+        config = PARALLEL_JP;
+
+    } else if (token == "SMALLEST_LAST") {
+        config = SMALLEST_LAST;
+
+    } else if (token == "PLANAR5") {
+        config = PLANAR5;
+
+    } else if (token == "TABUCOL") {
+        config = TABUCOL;
+    } else if (token == "HEA") {
+        config = HEA;
+
+    } else {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+std::ostream &operator<<(std::ostream& out, Config config)
+{
+    switch (config) {
+    case DSATUR:
+        return out << "DSATUR";
+    case DSATUR_BINARY_HEAP:
+        return out << "DSATUR_BINARY_HEAP";
+    case DSATUR_FIBONACCI_HEAP:
+        return out << "DSATUR_FIBONACCI_HEAP";
+    case DSATUR_SEWELL:
+        return out << "DSATUR_SEWELL";
+    case DSATUR_PASS:
+        return out << "DSATUR_PASS";
+    case DSATUR_BUCKET:
+        return out << "DSATUR_BUCKET";
+    case DSATUR_DARY_HEAP:
+        return out << "DSATUR_DARY_HEAP";
+    case BNB_DSATUR:
+        return out << "BNB_DSATUR";
+    case BNB_DSATUR_SEWELL:
+        return out << "BNB_DSATUR_SEWELL";
+    case BNB_DSATUR_PASS:
+        return out << "BNB_DSATUR_PASS";
+    case PARALLEL_JP:
+        return out << "PARALLEL_JP";
+    case SMALLEST_LAST:
+        return out << "SMALLEST_LAST";
+    case PLANAR5:
+        return out << "PLANAR5";
+    case TABUCOL:
+        return out << "TABUCOL";
+    case HEA:
+        return out << "HEA";
+    default:
+        return out << "UNKNOWN";
+    }
+}
+
+std::istream &operator>>(std::istream& in, Improvement& improvement)
+{
+    std::string token;
+    in >> token;
+
+    for (auto &ch: token) {
+        ch = std::tolower(ch);
+    }
+
+    if (token == "none") {
+        improvement = Improvement::NONE;
+    } else if (token == "iterated-greedy") {
+        improvement = Improvement::ITERATED_GREEDY;
     } else {
         in.setstate(std::ios_base::failbit);
     }
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <istream>
+#include <ostream>
 #include <cctype>
 
 namespace solver {
@@ -10,19 +11,48 @@ enum Config: uint16_t {
     DSATUR_BINARY_HEAP,     // O((m + n)logn)
     DSATUR_FIBONACCI_HEAP,  // O(m + nlogn)
 
-    DSATUR_SEWELL,          // O(n^3)
-    DSATUR_PASS,            // O(n^3) in worst case, O(n^2) on average
+    DSATUR_SEWELL,          // O(n^2) scans, Same scores recomputed in 2-hop neighbourhoods
+    DSATUR_PASS,            // as SEWELL, Same scores only near the last colors
+
+    DSATUR_BUCKET,          // O(n + m) bucket moves, each O(log_64 n)
+    DSATUR_DARY_HEAP,       // O((m + n)logn) on a flat 4-ary heap
 
     __DSATUR_BOUND,
 
     BNB_DSATUR,             // BnB with O(n^2) check    
-    BNB_DSATUR_SEWELL,      // BnB with O(n^3) check
-    BNB_DSATUR_PASS,        // BnB with O(n^3) in worst case, O(n^2) on average
+    BNB_DSATUR_SEWELL,      // BnB with cached Same scores
+    BNB_DSATUR_PASS,        // BnB with cached Same scores near the last colors
 
     __BNB_DSATUR_BOUND,
 
+    PARALLEL_JP,            // Jones-Plassmann, O(n + m) work split over threads
+
+    __PARALLEL_BOUND,
+
+    SMALLEST_LAST,          // O(n + m), at most degeneracy + 1 colors
+
+    __GREEDY_BOUND,
+
+    PLANAR5,                // smallest-last with Kempe chain swaps, at most 5 colors, O(n^2) worst case
+
+    __PLANAR_BOUND,
+
+    TABUCOL,                // DSATUR, then Tabucol for one color less down to the clique LB
+    HEA,                    // as TABUCOL with a population per thread and GPX crossover
+
+    __LOCAL_SEARCH_BOUND,
+
     __END
 };
 
 std::istream &operator >>(std::istream& in, Config& config);
+std::ostream &operator <<(std::ostream& out, Config config);
+
+// post-processing of heuristic colorings
+enum class Improvement: uint8_t {
+    NONE,
+    ITERATED_GREEDY,        // Culberson: greedy passes over permuted color classes
+};
+
+std::istream &operator >>(std::istream& in, Improvement& improvement);
 } // namespace solver
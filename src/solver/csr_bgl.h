@@ -0,0 +1,273 @@
+#pragma once
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <vector>
+
+#include "graph.h"
+
+namespace solver {
+struct CsrBglTraversalCategory:
+    boost::incidence_graph_tag,
+    boost::vertex_list_graph_tag,
+    boost::edge_list_graph_tag {};
+
+// Read-only Boost.Graph view of CsrGraph for the planarity algorithms. Each undirected
+// edge {v, u}, v < u, gets a dense index: its rank among the upper neighbours of v
+// offset by the number of upper neighbours of all vertices before v.
+class CsrBglView {
+public:
+    struct Edge {
+        Vertex source;
+        Vertex target;
+        SizeType index;
+
+        // both directions of an edge are the same descriptor
+        bool operator==(Edge const& other) const noexcept
+        {
+            return index == other.index;
+        }
+
+        bool operator!=(Edge const& other) const noexcept
+        {
+            return index != other.index;
+        }
+    };
+
+    class OutEdgeIterator;
+    class EdgeIterator;
+
+    // Boost.Graph traits
+    using vertex_descriptor = Vertex;
+    using edge_descriptor = Edge;
+
+    using directed_category = boost::undirected_tag;
+    using edge_parallel_category = boost::disallow_parallel_edge_tag;
+    using traversal_category = CsrBglTraversalCategory;
+
+    using vertex_iterator = boost::counting_iterator<Vertex>;
+    using out_edge_iterator = OutEdgeIterator;
+    using edge_iterator = EdgeIterator;
+
+    using vertices_size_type = SizeType;
+    using edges_size_type = SizeType;
+    using degree_size_type = SizeType;
+
+    static vertex_descriptor null_vertex() noexcept
+    {
+        return std::numeric_limits<vertex_descriptor>::max();
+    }
+
+    class OutEdgeIterator: public boost::iterator_facade<
+        OutEdgeIterator, Edge, boost::forward_traversal_tag, Edge
+    > {
+    public:
+        OutEdgeIterator() = default;
+
+        OutEdgeIterator(CsrBglView const *view, Vertex v, SizeType pos)
+            : mView(view)
+            , mSource(v)
+            , mPos(pos)
+        {
+        }
+
+    private:
+        friend class boost::iterator_core_access;
+
+        Edge dereference() const
+        {
+            Vertex u = mView->mGraph.Neighbours(mSource)[mPos];
+            return {mSource, u, mView->EdgeIndex(mSource, mPos)};
+        }
+
+        bool equal(OutEdgeIterator const& other) const noexcept
+        {
+            return mPos == other.mPos && mSource == other.mSource;
+        }
+
+        void increment() noexcept
+        {
+            ++mPos;
+        }
+
+        CsrBglView const *mView { nullptr };
+        Vertex mSource { 0 };
+        SizeType mPos { 0 };
+    };
+
+    // walks the upper half of every neighbour list, so edges come out in index order
+    class EdgeIterator: public boost::iterator_facade<
+        EdgeIterator, Edge, boost::forward_traversal_tag, Edge
+    > {
+    public:
+        EdgeIterator() = default;
+
+        EdgeIterator(CsrBglView const *view, Vertex v)
+            : mView(view)
+            , mSource(v)
+        {
+            Settle();
+        }
+
+    private:
+        friend class boost::iterator_core_access;
+
+        Edge dereference() const
+        {
+            return {mSource, mView->mGraph.Neighbours(mSource)[mPos], mView->EdgeIndex(mSource, mPos)};
+        }
+
+        bool equal(EdgeIterator const& other) const noexcept
+        {
+            return mSource == other.mSource && mPos == other.mPos;
+        }
+
+        void increment()
+        {
+            ++mPos;
+            Settle();
+        }
+
+        // moves to the next vertex with upper neighbours left
+        void Settle()
+        {
+            auto const n = mView->mGraph.NumVertices();
+            if (mSource < n && mPos < mView->mUpperBegin[mSource]) {
+                mPos = mView->mUpperBegin[mSource];
+            }
+            while (mSource < n && mPos == mView->mGraph.Degree(mSource)) {
+                ++mSource;
+                mPos = mSource < n ? mView->mUpperBegin[mSource] : 0;
+            }
+        }
+
+        CsrBglView const *mView { nullptr };
+        Vertex mSource { 0 };
+        SizeType mPos { 0 };
+    };
+
+    explicit CsrBglView(Graph const& g)
+        : mGraph(g)
+        , mUpperBegin(g.NumVertices())
+        , mUpperStart(g.NumVertices() + 1, 0)
+    {
+        for (Vertex v = 0; v < g.NumVertices(); ++v) {
+            auto neighbours = g.Neighbours(v);
+            mUpperBegin[v] = std::upper_bound(neighbours.begin(), neighbours.end(), v) - neighbours.begin();
+            mUpperStart[v + 1] = mUpperStart[v] + neighbours.size() - mUpperBegin[v];
+        }
+    }
+
+    Graph const& Base() const noexcept
+    {
+        return mGraph;
+    }
+
+    // index of the edge leading to the neighbour at position pos in the list of v
+    SizeType EdgeIndex(Vertex v, SizeType pos) const noexcept
+    {
+        if (pos >= mUpperBegin[v]) {
+            return mUpperStart[v] + pos - mUpperBegin[v];
+        }
+        Vertex u = mGraph.Neighbours(v)[pos];
+        auto neighbours = mGraph.Neighbours(u);
+        SizeType reversePos = std::lower_bound(neighbours.begin(), neighbours.end(), v) - neighbours.begin();
+        return mUpperStart[u] + reversePos - mUpperBegin[u];
+    }
+
+private:
+    Graph const& mGraph;
+
+    // position of the first neighbour greater than v
+    std::vector<uint32_t> mUpperBegin;
+    // index of the first edge {v, u} with v < u
+    std::vector<SizeType> mUpperStart;
+};
+
+// property map of dense edge indices
+struct CsrEdgeIndexMap {
+    using key_type = CsrBglView::Edge;
+    using value_type = SizeType;
+    using reference = SizeType;
+    using category = boost::readable_property_map_tag;
+};
+
+inline SizeType get(CsrEdgeIndexMap, CsrBglView::Edge const& e) noexcept
+{
+    return e.index;
+}
+
+inline auto get(boost::vertex_index_t, CsrBglView const&) noexcept
+{
+    return boost::typed_identity_property_map<Vertex>();
+}
+
+inline auto get(boost::edge_index_t, CsrBglView const&) noexcept
+{
+    return CsrEdgeIndexMap();
+}
+
+inline auto vertices(CsrBglView const& view)
+{
+    using It = boost::counting_iterator<Vertex>;
+    return std::make_pair(It(0), It(static_cast<Vertex>(view.Base().NumVertices())));
+}
+
+inline SizeType num_vertices(CsrBglView const& view) noexcept
+{
+    return view.Base().NumVertices();
+}
+
+inline auto out_edges(Vertex v, CsrBglView const& view)
+{
+    using It = CsrBglView::OutEdgeIterator;
+    return std::make_pair(It(&view, v, 0), It(&view, v, view.Base().Degree(v)));
+}
+
+inline SizeType out_degree(Vertex v, CsrBglView const& view) noexcept
+{
+    return view.Base().Degree(v);
+}
+
+inline auto edges(CsrBglView const& view)
+{
+    using It = CsrBglView::EdgeIterator;
+    return std::make_pair(It(&view, 0), It(&view, static_cast<Vertex>(view.Base().NumVertices())));
+}
+
+inline SizeType num_edges(CsrBglView const& view) noexcept
+{
+    return view.Base().NumEdges();
+}
+
+inline Vertex source(CsrBglView::Edge const& e, CsrBglView const&) noexcept
+{
+    return e.source;
+}
+
+inline Vertex target(CsrBglView::Edge const& e, CsrBglView const&) noexcept
+{
+    return e.target;
+}
+} // namespace solver
+
+namespace boost {
+template <>
+struct property_map<solver::CsrBglView, vertex_index_t> {
+    using type = typed_identity_property_map<solver::Vertex>;
+    using const_type = type;
+};
+
+template <>
+struct property_map<solver::CsrBglView, edge_index_t> {
+    using type = solver::CsrEdgeIndexMap;
+    using const_type = type;
+};
+} // namespace boost
@@ -0,0 +1,318 @@
+#include "decomposition.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <limits>
+#include <array>
+#include <span>
+
+#include "reduction.h"
+
+namespace solver {
+namespace {
+// newId is scratch space of NO_VERTEX entries, they are restored before the return
+Block MakeBlock(Graph const& g, std::vector<Vertex> vertices, std::vector<Vertex> &newId)
+{
+    std::ranges::sort(vertices);
+    for (Vertex i = 0; i < vertices.size(); ++i) {
+        newId[vertices[i]] = i;
+    }
+    auto graph = InducedSubgraph(g, vertices, newId);
+    for (auto v: vertices) {
+        newId[v] = NO_VERTEX;
+    }
+    return {std::move(graph), std::move(vertices)};
+}
+} // namespace
+
+Decomposition BiconnectedBlocks(Graph const& g)
+{
+    using Edge = utils::AdjacencyArrays::EdgeType;
+
+    auto const n = g.NumVertices();
+    Decomposition decomposition;
+
+    // Hopcroft-Tarjan with explicit stacks: discovery time (0 for unvisited vertices),
+    // lowpoint and DFS parent of every vertex
+    std::vector<Vertex> discovery(n, 0);
+    std::vector<Vertex> low(n, 0);
+    std::vector<Vertex> parent(n, NO_VERTEX);
+    // DFS path with the next neighbour to look at, tree and back edges not in a block yet
+    std::vector<std::pair<Vertex, SizeType>> path;
+    std::vector<Edge> edges;
+    std::vector<Vertex> newId(n, NO_VERTEX);
+
+    // a block is built from its own edges only, so the total work stays O(n + m)
+    // however many blocks share a cut vertex
+    auto addBlock = [&decomposition, &newId](std::span<Edge const> blockEdges) {
+        std::vector<Vertex> vertices;
+        for (auto [u, v]: blockEdges) {
+            for (auto w: {u, v}) {
+                if (newId[w] == NO_VERTEX) {
+                    newId[w] = 0;
+                    vertices.push_back(w);
+                }
+            }
+        }
+        std::ranges::sort(vertices);
+        for (Vertex i = 0; i < vertices.size(); ++i) {
+            newId[vertices[i]] = i;
+        }
+
+        std::vector<Edge> local;
+        local.reserve(blockEdges.size());
+        for (auto [u, v]: blockEdges) {
+            local.emplace_back(newId[u], newId[v]);
+        }
+        for (auto v: vertices) {
+            newId[v] = NO_VERTEX;
+        }
+
+        auto graph = Graph(utils::AdjacencyArrays::FromEdges(vertices.size(), local));
+        decomposition.blocks.push_back({std::move(graph), std::move(vertices)});
+    };
+
+    Vertex time = 0;
+    for (Vertex root = 0; root < n; ++root) {
+        if (discovery[root]) {
+            continue;
+        }
+        ++decomposition.numComponents;
+        discovery[root] = low[root] = ++time;
+        if (g.Degree(root) == 0) {
+            decomposition.blocks.push_back({Graph(utils::AdjacencyArrays::FromEdges(1, {})), {root}});
+            continue;
+        }
+
+        path.emplace_back(root, 0);
+        while (true) {
+            auto const [v, next] = path.back();
+            auto const neighbours = g.Neighbours(v);
+            if (next < neighbours.size()) {
+                ++path.back().second;
+                auto const u = neighbours[next];
+                if (!discovery[u]) {
+                    discovery[u] = low[u] = ++time;
+                    parent[u] = v;
+                    path.emplace_back(u, 0);
+                    edges.emplace_back(v, u);
+                } else if (u != parent[v] && discovery[u] < discovery[v]) {
+                    // the edge is seen from below first, from u it leads to a descendant
+                    low[v] = std::min(low[v], discovery[u]);
+                    edges.emplace_back(v, u);
+                }
+                continue;
+            }
+
+            path.pop_back();
+            if (path.empty()) {
+                break;
+            }
+            auto const p = path.back().first;
+            low[p] = std::min(low[p], low[v]);
+            if (low[v] < discovery[p]) {
+                continue;
+            }
+
+            // no back edge leaves the subtree of v above p: the edges stacked since the
+            // tree edge (p, v) form a block
+            auto const first = std::find(edges.rbegin(), edges.rend(), Edge(p, v)).base() - 1;
+            addBlock({first, edges.end()});
+            edges.erase(first, edges.end());
+        }
+    }
+
+    // blocks come out children first, a block only shares its top vertex with the
+    // ones after it
+    std::ranges::reverse(decomposition.blocks);
+    return decomposition;
+}
+
+ColorType MergeColorings(
+    Graph const& g, Decomposition const& decomposition,
+    std::vector<Coloring> const& blockColorings, Coloring &coloring
+)
+{
+    coloring.assign(g.NumVertices(), -1);
+
+    ColorType ncolors = 0;
+    for (size_t b = 0; b < decomposition.blocks.size(); ++b) {
+        auto const& vertices = decomposition.blocks[b].vertices;
+        auto const& blockColoring = blockColorings[b];
+
+        // the color of the cut vertex in the block is swapped with the one it already has
+        ColorType from = 0;
+        ColorType to = 0;
+        for (Vertex i = 0; i < vertices.size(); ++i) {
+            if (coloring[vertices[i]] != -1) {
+                from = blockColoring[i];
+                to = coloring[vertices[i]];
+                break;
+            }
+        }
+
+        for (Vertex i = 0; i < vertices.size(); ++i) {
+            auto const c = blockColoring[i];
+            coloring[vertices[i]] = c == from ? to : c == to ? from : c;
+            ncolors = std::max(ncolors, coloring[vertices[i]] + 1);
+        }
+    }
+
+    return ncolors;
+}
+
+Partition SeparatorPartition(Graph const& g, SizeType maxSize)
+{
+    auto const n = g.NumVertices();
+    Partition partition;
+
+    // every part is a vertex list in work and an id in part, separator vertices are in no part
+    SizeType constexpr NO_PART = std::numeric_limits<SizeType>::max();
+    std::vector<SizeType> part(n, 0);
+    SizeType numParts = 1;
+    std::vector<std::vector<Vertex>> work(1, std::vector<Vertex>(n));
+    std::iota(work[0].begin(), work[0].end(), 0);
+
+    std::vector<Vertex> level(n, NO_VERTEX);
+    std::vector<Vertex> newId(n, NO_VERTEX);
+    // vertices reached by the last BFS, level by level
+    std::vector<Vertex> order;
+
+    auto bfs = [&g, &part, &level, &order](Vertex start) {
+        for (auto v: order) {
+            level[v] = NO_VERTEX;
+        }
+        order.assign(1, start);
+        level[start] = 0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            for (auto u: g.Neighbours(order[i])) {
+                if (part[u] == part[start] && level[u] == NO_VERTEX) {
+                    level[u] = level[order[i]] + 1;
+                    order.push_back(u);
+                }
+            }
+        }
+    };
+
+    while (!work.empty()) {
+        auto vertices = std::move(work.back());
+        work.pop_back();
+        if (vertices.empty()) {
+            continue;
+        }
+        if (vertices.size() <= maxSize) {
+            partition.pieces.push_back(MakeBlock(g, std::move(vertices), newId));
+            continue;
+        }
+
+        // a part that falls apart is split into its components in a single pass: the small
+        // ones are packed into pieces without a cut, only the large ones are cut later
+        bfs(vertices.front());
+        if (order.size() < vertices.size()) {
+            auto const id = part[vertices.front()];
+            std::vector<Vertex> bundle;
+            for (auto v: vertices) {
+                if (part[v] != id) {
+                    continue;
+                }
+                bfs(v);
+                for (auto u: order) {
+                    part[u] = numParts;
+                }
+                ++numParts;
+
+                if (order.size() > maxSize) {
+                    work.push_back(order);
+                    continue;
+                }
+                if (bundle.size() + order.size() > maxSize) {
+                    partition.pieces.push_back(MakeBlock(g, std::move(bundle), newId));
+                    bundle.clear();
+                }
+                bundle.insert(bundle.end(), order.begin(), order.end());
+            }
+            if (!bundle.empty()) {
+                partition.pieces.push_back(MakeBlock(g, std::move(bundle), newId));
+            }
+            for (auto v: order) {
+                level[v] = NO_VERTEX;
+            }
+            order.clear();
+            continue;
+        }
+
+        // the last vertex of a BFS starts a deeper one, with more and thinner levels
+        bfs(order.back());
+
+        std::vector<SizeType> sizes(level[order.back()] + 1, 0);
+        for (auto v: order) {
+            ++sizes[level[v]];
+        }
+
+        // the thinnest level with at least a third of the reached vertices on both sides,
+        // the median level if there is none
+        SizeType const third = order.size() / 3;
+        Vertex cut = NO_VERTEX;
+        Vertex median = NO_VERTEX;
+        SizeType before = 0;
+        for (Vertex l = 0; l < sizes.size(); ++l) {
+            SizeType const after = order.size() - before - sizes[l];
+            if (before >= third && after >= third && (cut == NO_VERTEX || sizes[l] < sizes[cut])) {
+                cut = l;
+            }
+            if (median == NO_VERTEX && 2 * (before + sizes[l]) > order.size()) {
+                median = l;
+            }
+            before += sizes[l];
+        }
+        if (cut == NO_VERTEX) {
+            cut = median;
+        }
+
+        // the levels below and above the cut are new parts
+        std::array<SizeType, 2> const ids { numParts, numParts + 1 };
+        numParts += ids.size();
+        std::array<std::vector<Vertex>, 2> parts;
+        for (auto v: vertices) {
+            if (level[v] == cut) {
+                part[v] = NO_PART;
+                partition.separator.push_back(v);
+                continue;
+            }
+            size_t const i = level[v] < cut ? 0 : 1;
+            part[v] = ids[i];
+            parts[i].push_back(v);
+        }
+        for (auto &newPart: parts) {
+            work.push_back(std::move(newPart));
+        }
+
+        for (auto v: order) {
+            level[v] = NO_VERTEX;
+        }
+        order.clear();
+    }
+
+    return partition;
+}
+
+ColorType JoinPieces(
+    Graph const& g, Partition const& partition,
+    std::vector<Coloring> const& pieceColorings, Coloring &coloring
+)
+{
+    coloring.assign(g.NumVertices(), -1);
+
+    ColorType ncolors = 0;
+    for (size_t p = 0; p < partition.pieces.size(); ++p) {
+        auto const& vertices = partition.pieces[p].vertices;
+        for (Vertex i = 0; i < vertices.size(); ++i) {
+            coloring[vertices[i]] = pieceColorings[p][i];
+            ncolors = std::max(ncolors, pieceColorings[p][i] + 1);
+        }
+    }
+
+    return std::max(ncolors, FirstFit(g, partition.separator, coloring));
+}
+} // namespace solver
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "graph.h"
+
+namespace solver {
+// Biconnected block of a graph as a graph of its own.
+struct Block {
+    Graph graph;
+    // vertices[blockId] == id in the whole graph, in ascending order
+    std::vector<Vertex> vertices;
+};
+
+// Blocks ordered so that every block shares at most one vertex, a cut vertex, with the
+// blocks before it. Isolated vertices are blocks of one vertex.
+struct Decomposition {
+    std::vector<Block> blocks;
+    SizeType numComponents { 0 };
+};
+
+Decomposition BiconnectedBlocks(Graph const& g);
+
+// Stitches the colorings of all blocks into a coloring of g, renaming two colors of
+// every block so that it agrees with the blocks before it at its cut vertex.
+// Returns the number of colors, the max over the blocks.
+ColorType MergeColorings(
+    Graph const& g, Decomposition const& decomposition,
+    std::vector<Coloring> const& blockColorings, Coloring &coloring
+);
+
+// Pieces of at most maxSize vertices left after recursively removing BFS level separators,
+// an approximation of Lipton-Tarjan: no edge joins two different pieces. Components are
+// never cut, small ones are packed together into pieces.
+struct Partition {
+    std::vector<Block> pieces;
+    // removed levels, in removal order
+    std::vector<Vertex> separator;
+};
+
+Partition SeparatorPartition(Graph const& g, SizeType maxSize);
+
+// Copies the colorings of all pieces into a coloring of g and colors the separator first
+// fit. Returns the number of colors.
+ColorType JoinPieces(
+    Graph const& g, Partition const& partition,
+    std::vector<Coloring> const& pieceColorings, Coloring &coloring
+);
+} // namespace solver
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <boost/graph/boyer_myrvold_planar_test.hpp>
+
+#include <optional>
+#include <vector>
+
+#include "csr_bgl.h"
+#include "graph.h"
+
+namespace solver {
+// Boyer-Myrvold planar embedding: the edges around every vertex in clockwise order.
+using Embedding = std::vector<std::vector<CsrBglView::Edge>>;
+
+// std::nullopt if the graph is not planar
+inline std::optional<Embedding> PlanarEmbedding(Graph const& csr)
+{
+    CsrBglView g(csr);
+    Embedding embedding(csr.NumVertices());
+
+    namespace P = boost::boyer_myrvold_params; 
+    bool isPlanar = boost::boyer_myrvold_planarity_test(
+        P::graph = g,
+        P::embedding = embedding.data(),
+        P::edge_index_map = CsrEdgeIndexMap(),
+        P::vertex_index_map = boost::typed_identity_property_map<Vertex>()
+    );
+
+    if (!isPlanar) {
+        return std::nullopt;
+    }
+    return embedding;
+}
+} // namespace solver
@@ -2,16 +2,34 @@
 
 namespace solver::exact {
 namespace detail {
-inline DSaturData *Data(DataMap dataMap, Vertex v)
-{
-    return static_cast<DSaturData *>(dataMap[v].get());
-}
-
 struct Solution {
     std::vector<ColorType> coloring;
     std::stack<ColorType> maxColor;
     ColorType currentMaxColor;
-    ColorType answer = 5;
+    ColorType answer = BNB_COLOR_BOUND;
+    Incumbent *incumbent = nullptr;
+    // the time limit cut the search short
+    bool stopped = false;
+
+    // colorings must use fewer colors than this to be worth finding
+    ColorType Bound() const
+    {
+        if (!incumbent) {
+            return answer;
+        }
+        return std::min(answer, incumbent->load(std::memory_order_relaxed));
+    }
+
+    void Found(ColorType ncolors)
+    {
+        answer = ncolors;
+        if (!incumbent) {
+            return;
+        }
+        auto current = incumbent->load(std::memory_order_relaxed);
+        while (ncolors < current && !incumbent->compare_exchange_weak(current, ncolors)) {
+        }
+    }
 
     void PushColor(ColorType c)
     {
@@ -27,68 +45,81 @@ struct Solution {
 
     void UpdateMaxColor()
     {
-        currentMaxColor = std::min(maxColor.top() + 1, answer - 1);
+        currentMaxColor = std::min(maxColor.top() + 1, Bound() - 1);
     }
 };
 
+template <typename Selector, typename GraphType>
+void RestoreNeighbourColors(
+    GraphType const& g, DSaturState &state, Selector &selector,
+    Vertex v, DSaturState::MaskType neighbourColors
+)
+{
+    if (state.neighbourColors[v] != neighbourColors) {
+        state.SetNeighbourColors(v, neighbourColors);
+        selectors::NotifyChanged(selector, v, g);
+    }
+}
+
+template <selectors::CandidateSelector Selector, typename GraphType>
 void DSaturCore(
-    Graph &g, selectors::ICandidateSelector::Ptr selector,
+    GraphType const& g, Coloring &colorMap, DSaturState &state, Selector &selector,
     Solution &solution, TimeLimitFuncCRef timeLimitFunctor
 )
 {
     if (timeLimitFunctor()) {
+        solution.stopped = true;
         return;
     }
 
-    if (solution.maxColor.top() >= solution.answer) {
+    if (solution.maxColor.top() >= solution.Bound()) {
         return;
     }
 
-    if (selector->Empty()) {
-        solution.answer = solution.maxColor.top();
+    if (selector.Empty()) {
+        solution.Found(solution.maxColor.top());
 
-        auto colorMap = boost::get(&VertexProperty::color, g);
-        for (auto v: boost::make_iterator_range(boost::vertices(g))) {
-            colorMap[v] = solution.coloring[v];
-        }
+        colorMap = solution.coloring;
 
         return;
     }
 
-    auto dataMap = boost::get(&VertexProperty::data, g);
+    auto v = selector.Pop(g);
+    auto vNeighboursCache = state.neighbourColors[v];
 
-    auto v = selector->Pop(g);
-    auto vNeighboursCache = Data(dataMap, v)->neighbourColors;
-
-    for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
-        if (Data(dataMap, u)->colored) {
-            Data(dataMap, v)->Mark(solution.coloring[u]);
+    for (auto u: g.Neighbours(v)) {
+        if (state.colored[u] && state.Mark(v, solution.coloring[u])) {
+            selectors::NotifyChanged(selector, v, g);
         }
     }
 
-    auto admissibleColors = Data(dataMap, v)->F();
+    auto admissibleColors = state.F(v);
 
-    assert(!Data(dataMap, v)->colored);
+    assert(!state.colored[v]);
 
     for (ColorType nextColor = 0; nextColor < solution.currentMaxColor; ++nextColor) {
         if (admissibleColors & (1 << nextColor)) {
             if (timeLimitFunctor()) {
+                solution.stopped = true;
                 return;
             }
 
             solution.coloring[v] = nextColor;
-            Data(dataMap, v)->colored = true;
+            state.colored[v] = true;
+            selectors::NotifyChanged(selector, v, g);
             solution.PushColor(nextColor);
 
-            using CacheData = std::pair<Vertex, decltype(DSaturData::neighbourColors)>;
+            using CacheData = std::pair<Vertex, DSaturState::MaskType>;
             std::stack<CacheData> cache;
 
-            for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
-                if (!Data(dataMap, u)->colored) {
-                    cache.emplace(u, Data(dataMap, u)->neighbourColors);
-                    Data(dataMap, u)->Mark(nextColor);
+            for (auto u: g.Neighbours(v)) {
+                if (!state.colored[u]) {
+                    cache.emplace(u, state.neighbourColors[u]);
+                    if (state.Mark(u, nextColor)) {
+                        selectors::NotifyChanged(selector, u, g);
+                    }
 
-                    if (Data(dataMap, u)->F()) {
+                    if (state.F(u)) {
                         continue;
                     }
 
@@ -98,74 +129,103 @@ void DSaturCore(
                         auto [u, neighbourColors] = cache.top();
                         cache.pop();
 
-                        Data(dataMap, u)->neighbourColors = neighbourColors;
+                        RestoreNeighbourColors(g, state, selector, u, neighbourColors);
                     }
 
-                    Data(dataMap, v)->colored = false;
+                    state.colored[v] = false;
+                    selectors::NotifyChanged(selector, v, g);
                     solution.PopColor();  
                     
-                    selector->Push(v);
-                    Data(dataMap, v)->neighbourColors = vNeighboursCache;
+                    selector.Push(v);
+                    RestoreNeighbourColors(g, state, selector, v, vNeighboursCache);
                     return;
                 }
             }
 
-            DSaturCore(g, selector, solution, timeLimitFunctor);
+            DSaturCore(g, colorMap, state, selector, solution, timeLimitFunctor);
 
             while (!cache.empty()) {
                 auto [u, neighbourColors] = cache.top();
                 cache.pop();
 
-                Data(dataMap, u)->neighbourColors = neighbourColors;
+                RestoreNeighbourColors(g, state, selector, u, neighbourColors);
             }
 
-            Data(dataMap, v)->colored = false;
+            state.colored[v] = false;
+            selectors::NotifyChanged(selector, v, g);
             solution.PopColor();    
         }
     }
 
-    selector->Push(v);
-    Data(dataMap, v)->neighbourColors = vNeighboursCache;
+    selector.Push(v);
+    RestoreNeighbourColors(g, state, selector, v, vNeighboursCache);
 }
 
-ColorType BnB(Graph &g, selectors::ICandidateSelector::Ptr selector, TimeLimitFuncCRef timeLimitFunctor)
+template <selectors::CandidateSelector Selector, typename GraphType>
+ColorType BnB(
+    GraphType const& g, Coloring &colorMap, TimeLimitFuncCRef timeLimitFunctor,
+    Incumbent *incumbent, ColorType *lowerBound
+)
 {
-    auto const n = boost::num_vertices(g);
-    
-    auto dataMap = boost::get(&VertexProperty::data, g);
-    auto colorMap = boost::get(&VertexProperty::color, g);
-    selector->Init(n, dataMap);
+    Selector selector;
+    auto const n = g.NumVertices();
 
     Solution solution;
+    solution.incumbent = incumbent;
     solution.coloring.assign(n, 0);
 
-    for (auto v: boost::make_iterator_range(boost::vertices(g))) {      
-        dataMap[v] = std::make_shared<DSaturData>(v, boost::out_degree(v, g), solution.currentMaxColor);
-        colorMap[v] = 0;
+    DSaturState state;
+    state.Init(g, solution.currentMaxColor);
+    colorMap.assign(n, 0);
+    selector.Init(n, state);
 
-        selector->Push(v);
+    for (Vertex v = 0; v < n; ++v) {
+        selector.Push(v);
     }
 
     solution.maxColor.push(1);
     solution.currentMaxColor = solution.maxColor.top();
 
-    DSaturCore(g, selector, solution, timeLimitFunctor);
+    DSaturCore(g, colorMap, state, selector, solution, timeLimitFunctor);
 
+    if (lowerBound && !solution.stopped) {
+        *lowerBound = solution.Bound();
+    }
     return solution.answer;
 }
-}
 
-ColorType DSatur(Graph &g, Config config, TimeLimitFuncCRef timeLimitFunctor)
+template <typename GraphType>
+ColorType DSatur(
+    GraphType const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor,
+    Incumbent *incumbent, ColorType *lowerBound
+)
 {
-    selectors::ICandidateSelector::Ptr selector;
-    if (config == BNB_DSATUR) {
-        selector = std::make_shared<selectors::DenseCandidateSelector>();
-    } else if (config == BNB_DSATUR_SEWELL) {
-        selector = std::make_shared<selectors::SewellCandidateSelector>();
-    } else if (config == BNB_DSATUR_PASS) {
-        selector = std::make_shared<selectors::PassCandidateSelector>();
+    switch (config) {
+    case BNB_DSATUR:
+        return BnB<selectors::DenseCandidateSelector>(g, coloring, timeLimitFunctor, incumbent, lowerBound);
+    case BNB_DSATUR_SEWELL:
+        return BnB<selectors::SewellCandidateSelector>(g, coloring, timeLimitFunctor, incumbent, lowerBound);
+    case BNB_DSATUR_PASS:
+        return BnB<selectors::PassCandidateSelector>(g, coloring, timeLimitFunctor, incumbent, lowerBound);
+    default:
+        throw std::invalid_argument("Not an exact DSATUR config");
     }
+}
+} // namespace detail
 
-    return detail::BnB(g, selector, timeLimitFunctor);
+ColorType DSatur(
+    Graph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor,
+    Incumbent *incumbent, ColorType *lowerBound
+)
+{
+    return detail::DSatur(g, coloring, config, timeLimitFunctor, incumbent, lowerBound);
+}
+
+ColorType DSatur(
+    CompressedGraph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor,
+    Incumbent *incumbent, ColorType *lowerBound
+)
+{
+    return detail::DSatur(g, coloring, config, timeLimitFunctor, incumbent, lowerBound);
 }
 } // namespace solver::exact
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <boost/range/iterator_range.hpp>
-
+#include <stdexcept>
+#include <cassert>
 #include <vector>
 #include <stack>
 
@@ -9,9 +9,25 @@
 #include "../selectors/dsatur_sewell_selector.h"
 #include "../selectors/dsatur_pass_selector.h"
 
+#include "../compressed_graph.h"
 #include "../graph.h"
 #include "../config.h"
 
 namespace solver::exact {
-ColorType DSatur(Graph &g, Config config, TimeLimitFuncCRef timeLimitFunctor);
+// BnB only looks for colorings with fewer colors than this. When it finds none, it
+// returns this value and leaves a zero-filled coloring.
+inline ColorType constexpr BNB_COLOR_BOUND = 5;
+
+// A shared incumbent tightens the pruning bound whenever another solver improves it
+// and receives every coloring found here. Only colorings with fewer colors than the
+// bound are searched, so a search that runs to the end proves that none exists: it
+// sets lowerBound to that bound, a stopped one leaves it alone.
+ColorType DSatur(
+    Graph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor,
+    Incumbent *incumbent = nullptr, ColorType *lowerBound = nullptr
+);
+ColorType DSatur(
+    CompressedGraph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor,
+    Incumbent *incumbent = nullptr, ColorType *lowerBound = nullptr
+);
 } // namespace solver::exact
\ No newline at end of file
@@ -1,95 +1,159 @@
 #pragma once
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/graph_traits.hpp>
-
 #include <functional>
-#include <memory>
+#include <stdexcept>
+#include <cstdint>
+#include <atomic>
+#include <utility>
+#include <limits>
+#include <vector>
+#include <span>
+#include <bit>
+
+#include <adjacency_arrays.h>
 
 namespace solver {
-struct VertexProperty {
-    int32_t index;
-    int32_t color;
+// Immutable compressed sparse row graph: the neighbours of v are the sorted,
+// contiguous range targets[offsets[v], offsets[v + 1]) without self-loops and duplicates.
+class CsrGraph {
+public:
+    using Vertex = uint32_t;
+    using SizeType = size_t;
+    using NeighbourRange = std::span<Vertex const>;
+
+    CsrGraph() = default;
+
+    explicit CsrGraph(utils::AdjacencyArrays adjacency)
+        : mOffsets(std::move(adjacency.offsets))
+        , mTargets(std::move(adjacency.targets))
+    {
+        if (NumVertices() > std::numeric_limits<Vertex>::max()) {
+            throw std::runtime_error("Too many vertices for 32-bit ids");
+        }
+    }
 
-    std::shared_ptr<void> data;
+    SizeType NumVertices() const noexcept
+    {
+        return mOffsets.size() - 1;
+    }
 
-    VertexProperty() = default;
+    SizeType NumEdges() const noexcept
+    {
+        return mTargets.size() / 2;
+    }
 
-    explicit VertexProperty(int32_t i)
-        : index(i)
-        , color(0)
+    SizeType Degree(Vertex v) const noexcept
     {
+        return mOffsets[v + 1] - mOffsets[v];
     }
-};
 
-struct EdgeProperty {
-    int32_t index;
-};
+    NeighbourRange Neighbours(Vertex v) const noexcept
+    {
+        return {mTargets.data() + mOffsets[v], mTargets.data() + mOffsets[v + 1]};
+    }
 
-using Graph = boost::adjacency_list<
-    boost::hash_setS, boost::vecS, boost::undirectedS,
-    // vertex property
-    VertexProperty,
-    // edge property
-    EdgeProperty
->;
-using GraphTraits = boost::graph_traits<Graph>;
+    // position of the first neighbour of v in the targets array
+    SizeType Offset(Vertex v) const noexcept
+    {
+        return mOffsets[v];
+    }
 
-using Edge = GraphTraits::edge_descriptor;
-using Vertex = GraphTraits::vertex_descriptor;
+    // f(v, neighbours) for all vertices in id order.
+    template <typename Func>
+    void ForEachVertex(Func&& f) const
+    {
+        for (Vertex v = 0; v < NumVertices(); ++v) {
+            f(v, Neighbours(v));
+        }
+    }
 
-using SizeType = GraphTraits::vertices_size_type;
+    // Heap bytes held by the graph.
+    size_t MemoryUsage() const noexcept
+    {
+        return mOffsets.capacity() * sizeof(uint64_t) + mTargets.capacity() * sizeof(Vertex);
+    }
 
-using ColorType = decltype(VertexProperty::color);
-using ColorMap = boost::property_map<Graph, ColorType VertexProperty::*>::type;
+private:
+    std::vector<uint64_t> mOffsets { 0 };
+    std::vector<Vertex> mTargets;
+};
 
-using DataType = decltype(VertexProperty::data);
-using DataMap = boost::property_map<Graph, DataType VertexProperty::*>::type;
+using Graph = CsrGraph;
+
+using Vertex = Graph::Vertex;
+using SizeType = Graph::SizeType;
+
+using ColorType = int32_t;
+using Coloring = std::vector<ColorType>;
 
 using TimeLimitFunc = std::function<bool()>;
 using TimeLimitFuncCRef = TimeLimitFunc const&; 
 
-struct DSaturData {
-    SizeType index;
-    SizeType degree;
-
-    bool colored;
-    
-    uint32_t neighbourColors;
-    ColorType const& currentMaxColor;
-
-    explicit DSaturData(SizeType index, SizeType degree, ColorType const& currentMaxColor)
-        : index(index)
-        , degree(degree)
-        , colored(false)
-        , neighbourColors(0)
-        , currentMaxColor(currentMaxColor)
+// best color count known to all solvers of a portfolio run
+using Incumbent = std::atomic<ColorType>;
+
+// DSATUR state of all vertices, one contiguous array per field.
+struct DSaturState {
+    using MaskType = uint32_t;
+
+    std::vector<MaskType> neighbourColors;
+    std::vector<uint32_t> degree;
+    std::vector<uint8_t> colored;
+    // popcount of neighbourColors, kept in sync by Mark and SetNeighbourColors
+    std::vector<uint32_t> saturation;
+
+    ColorType const *currentMaxColor { nullptr };
+
+    template <typename GraphType>
+    void Init(GraphType const& g, ColorType const& maxColor)
     {
+        auto const n = g.NumVertices();
+        neighbourColors.assign(n, 0);
+        degree.resize(n);
+        colored.assign(n, false);
+        saturation.assign(n, 0);
+        currentMaxColor = &maxColor;
+
+        for (Vertex v = 0; v < n; ++v) {
+            degree[v] = g.Degree(v);
+        }
     }
 
-    void Mark(ColorType c) noexcept
+    // returns whether c is new to the neighbourhood of v
+    bool Mark(Vertex v, ColorType c) noexcept
     {
-        neighbourColors |= (1 << c);
+        MaskType const bit = 1u << c;
+        bool const isNew = !(neighbourColors[v] & bit);
+        saturation[v] += isNew;
+        neighbourColors[v] |= bit;
+        return isNew;
     }
 
-    uint32_t Filter(uint32_t val) const noexcept
+    void SetNeighbourColors(Vertex v, MaskType mask) noexcept
     {
-        return val & ((1u << currentMaxColor) - 1u);
-    } 
+        neighbourColors[v] = mask;
+        saturation[v] = std::popcount(mask);
+    }
+
+    MaskType Filter(MaskType val) const noexcept
+    {
+        return val & ((1u << *currentMaxColor) - 1u);
+    }
 
-    auto F() const noexcept
+    // admissible colours of v
+    MaskType F(Vertex v) const noexcept
     {
-        return Filter(~neighbourColors);
+        return Filter(~neighbourColors[v]);
     }
 
-    ColorType ColorMex() const noexcept
+    ColorType ColorMex(Vertex v) const noexcept
     {
-        return std::countr_one(Filter(neighbourColors));
+        return std::countr_one(Filter(neighbourColors[v]));
     }
 
-    size_t Saturation() const noexcept
+    SizeType Saturation(Vertex v) const noexcept
     {
-        return std::popcount(neighbourColors);
+        return saturation[v];
     }
 };
 } // namespace solver
@@ -2,25 +2,20 @@
 
 namespace solver::heuristics {
 namespace detail {
-inline DSaturData *Data(DataMap dataMap, Vertex v)
-{
-    return static_cast<DSaturData *>(dataMap[v].get());
-}
-
-ColorType DSaturCore(Graph &g, selectors::ICandidateSelector::Ptr selector, TimeLimitFuncCRef timeLimitFunctor)
+template <selectors::CandidateSelector Selector, typename GraphType>
+ColorType DSaturCore(GraphType const& g, Coloring &colorMap, TimeLimitFuncCRef timeLimitFunctor)
 {
+    Selector selector;
     ColorType maxColor = 0;
-    auto const n = boost::num_vertices(g);
-    
-    auto dataMap = boost::get(&VertexProperty::data, g);
-    auto colorMap = boost::get(&VertexProperty::color, g);
-    selector->Init(n, dataMap);
+    auto const n = g.NumVertices();
 
-    for (auto v: boost::make_iterator_range(boost::vertices(g))) {      
-        dataMap[v] = std::make_shared<DSaturData>(v, boost::out_degree(v, g), maxColor);
-        colorMap[v] = 0;
+    DSaturState state;
+    state.Init(g, maxColor);
+    colorMap.assign(n, 0);
+    selector.Init(n, state);
 
-        selector->Push(v);
+    for (Vertex v = 0; v < n; ++v) {
+        selector.Push(v);
     }
 
     for (SizeType _ = 0; _ < n; ++_) {
@@ -28,47 +23,67 @@ ColorType DSaturCore(Graph &g, selectors::ICandidateSelector::Ptr selector, Time
             return -1;
         }
 
-        auto v = selector->Pop(g);
+        auto v = selector.Pop(g);
 
-        for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
-            if (Data(dataMap, u)->colored) {
-                Data(dataMap, v)->Mark(colorMap[u]);
+        for (auto u: g.Neighbours(v)) {
+            if (state.colored[u]) {
+                state.Mark(v, colorMap[u]);
             }
         }
 
-        auto nextColor = Data(dataMap, v)->ColorMex();
+        auto nextColor = state.ColorMex(v);
         maxColor = std::max(maxColor, nextColor + 1);
 
         colorMap[v] = nextColor;
-        Data(dataMap, v)->colored = true;
+        state.colored[v] = true;
+        selectors::NotifyChanged(selector, v, g);
 
-        for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
-            if (!Data(dataMap, u)->colored) {
-                Data(dataMap, u)->Mark(nextColor);
-                selector->Update(u);
+        for (auto u: g.Neighbours(v)) {
+            if (!state.colored[u]) {
+                if (state.Mark(u, nextColor)) {
+                    selectors::NotifyChanged(selector, u, g);
+                }
+                if constexpr (selectors::UpdatableSelector<Selector>) {
+                    selector.Update(u);
+                }
             }
         }
     }
 
     return maxColor;
 }
-} // namespace detail
 
-ColorType DSatur(Graph &g, Config config, TimeLimitFuncCRef timeLimitFunctor)
+template <typename GraphType>
+ColorType DSatur(GraphType const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor)
 {
-    selectors::ICandidateSelector::Ptr selector;
-    if (config == DSATUR) {
-        selector = std::make_shared<selectors::DenseCandidateSelector>();
-    } else if (config == DSATUR_BINARY_HEAP) {
-        selector = std::make_shared<selectors::SparseCandidateSelectorBin>();
-    } else if (config == DSATUR_FIBONACCI_HEAP) {
-        selector = std::make_shared<selectors::SparseCandidateSelectorFib>();
-    } else if (config == DSATUR_SEWELL) {
-        selector = std::make_shared<selectors::SewellCandidateSelector>();
-    } else if (config == DSATUR_PASS) {
-        selector = std::make_shared<selectors::PassCandidateSelector>();
+    switch (config) {
+    case DSATUR:
+        return DSaturCore<selectors::DenseCandidateSelector>(g, coloring, timeLimitFunctor);
+    case DSATUR_BINARY_HEAP:
+        return DSaturCore<selectors::SparseCandidateSelectorBin>(g, coloring, timeLimitFunctor);
+    case DSATUR_FIBONACCI_HEAP:
+        return DSaturCore<selectors::SparseCandidateSelectorFib>(g, coloring, timeLimitFunctor);
+    case DSATUR_SEWELL:
+        return DSaturCore<selectors::SewellCandidateSelector>(g, coloring, timeLimitFunctor);
+    case DSATUR_PASS:
+        return DSaturCore<selectors::PassCandidateSelector>(g, coloring, timeLimitFunctor);
+    case DSATUR_BUCKET:
+        return DSaturCore<selectors::BucketCandidateSelector>(g, coloring, timeLimitFunctor);
+    case DSATUR_DARY_HEAP:
+        return DSaturCore<selectors::DaryHeapCandidateSelector>(g, coloring, timeLimitFunctor);
+    default:
+        throw std::invalid_argument("Not a heuristic DSATUR config");
     }
+}
+} // namespace detail
 
-    return detail::DSaturCore(g, selector, timeLimitFunctor);
+ColorType DSatur(Graph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor)
+{
+    return detail::DSatur(g, coloring, config, timeLimitFunctor);
+}
+
+ColorType DSatur(CompressedGraph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor)
+{
+    return detail::DSatur(g, coloring, config, timeLimitFunctor);
 }
 } // namespace solver::heuristics
@@ -1,15 +1,19 @@
 #pragma once
 
-#include <boost/range/iterator_range.hpp>
+#include <stdexcept>
 
+#include "../selectors/dsatur_bucket_selector.h"
+#include "../selectors/dsatur_dary_heap_selector.h"
 #include "../selectors/dsatur_sparse_selector.h"
 #include "../selectors/dsatur_dense_selector.h"
 #include "../selectors/dsatur_sewell_selector.h"
 #include "../selectors/dsatur_pass_selector.h"
 
 #include "../config.h"
+#include "../compressed_graph.h"
 #include "../graph.h"
 
 namespace solver::heuristics {
-ColorType DSatur(Graph &g, Config config, TimeLimitFuncCRef timeLimitFunctor);
+ColorType DSatur(Graph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor);
+ColorType DSatur(CompressedGraph const& g, Coloring &coloring, Config config, TimeLimitFuncCRef timeLimitFunctor);
 } // namespace solver::heuristics
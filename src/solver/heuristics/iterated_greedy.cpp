@@ -0,0 +1,109 @@
+#include "iterated_greedy.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace solver::heuristics {
+namespace detail {
+// Culberson's mix of class orders, out of 10 passes
+uint32_t constexpr REVERSE_SHARE = 5;
+uint32_t constexpr LARGEST_FIRST_SHARE = 3;
+
+template <typename GraphType>
+ColorType IteratedGreedy(
+    GraphType const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    uint64_t seed, TimeLimitFuncCRef stopFunctor, bool verbose
+)
+{
+    auto const n = g.NumVertices();
+    std::mt19937_64 gen(seed);
+
+    std::vector<SizeType> start;
+    std::vector<Vertex> byClass(n);
+    std::vector<ColorType> classOrder;
+    // colors around the current vertex, stamped with its id + 1
+    std::vector<Vertex> seen;
+
+    uint64_t stale = 0;
+    for (uint64_t pass = 1; ncolors > std::max<ColorType>(lowerBound, 1); ++pass) {
+        if (stale >= ITERATED_GREEDY_STALE_PASSES || stopFunctor()) {
+            break;
+        }
+
+        // counting sort of the vertices by class
+        start.assign(ncolors + 1, 0);
+        for (Vertex v = 0; v < n; ++v) {
+            ++start[coloring[v] + 1];
+        }
+        std::partial_sum(start.begin(), start.end(), start.begin());
+        {
+            auto fill = start;
+            for (Vertex v = 0; v < n; ++v) {
+                byClass[fill[coloring[v]]++] = v;
+            }
+        }
+
+        classOrder.resize(ncolors);
+        std::iota(classOrder.begin(), classOrder.end(), 0);
+        auto const strategy = gen() % 10;
+        if (strategy < REVERSE_SHARE) {
+            std::reverse(classOrder.begin(), classOrder.end());
+        } else if (strategy < REVERSE_SHARE + LARGEST_FIRST_SHARE) {
+            std::stable_sort(classOrder.begin(), classOrder.end(), [&start](ColorType lhs, ColorType rhs) {
+                return start[lhs + 1] - start[lhs] > start[rhs + 1] - start[rhs];
+            });
+        } else {
+            std::shuffle(classOrder.begin(), classOrder.end(), gen);
+        }
+
+        // first fit in the new order, the old colors are dropped as vertices are reached
+        std::fill(coloring.begin(), coloring.end(), -1);
+        seen.assign(ncolors + 1, 0);
+        ColorType used = 0;
+        for (auto c: classOrder) {
+            for (SizeType i = start[c]; i < start[c + 1]; ++i) {
+                Vertex const v = byClass[i];
+                for (auto u: g.Neighbours(v)) {
+                    if (coloring[u] >= 0) {
+                        seen[coloring[u]] = v + 1;
+                    }
+                }
+                ColorType next = 0;
+                while (seen[next] == v + 1) {
+                    ++next;
+                }
+                coloring[v] = next;
+                used = std::max(used, next + 1);
+            }
+        }
+
+        stale = used < ncolors ? 0 : stale + 1;
+        ncolors = used;
+        if (verbose) {
+            std::cout << "Iterated greedy pass " << pass << ": K=" << ncolors << std::endl;
+        }
+    }
+
+    return ncolors;
+}
+} // namespace detail
+
+ColorType IteratedGreedy(
+    Graph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    uint64_t seed, TimeLimitFuncCRef stopFunctor, bool verbose
+)
+{
+    return detail::IteratedGreedy(g, coloring, ncolors, lowerBound, seed, stopFunctor, verbose);
+}
+
+ColorType IteratedGreedy(
+    CompressedGraph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    uint64_t seed, TimeLimitFuncCRef stopFunctor, bool verbose
+)
+{
+    return detail::IteratedGreedy(g, coloring, ncolors, lowerBound, seed, stopFunctor, verbose);
+}
+} // namespace solver::heuristics
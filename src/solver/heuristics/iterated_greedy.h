@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../compressed_graph.h"
+#include "../graph.h"
+
+namespace solver::heuristics {
+// passes in a row without fewer colors after which IteratedGreedy gives up
+inline uint64_t constexpr ITERATED_GREEDY_STALE_PASSES = 100;
+
+// Culberson's iterated greedy: colors the vertices greedily class by class, with the
+// classes of the previous pass permuted (reversed, largest first or shuffled). A
+// class stays independent, so a pass never uses more colors. Every pass is O(n + m)
+// and reports its color count unless verbose is off. Stops at lowerBound colors, after
+// ITERATED_GREEDY_STALE_PASSES passes without progress or when stopFunctor fires.
+// Returns the number of colors, the coloring is valid on every exit.
+ColorType IteratedGreedy(
+    Graph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    uint64_t seed, TimeLimitFuncCRef stopFunctor, bool verbose = true
+);
+ColorType IteratedGreedy(
+    CompressedGraph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    uint64_t seed, TimeLimitFuncCRef stopFunctor, bool verbose = true
+);
+} // namespace solver::heuristics
@@ -0,0 +1,165 @@
+#include "kempe.h"
+
+#include <algorithm>
+
+namespace solver::heuristics {
+namespace detail {
+template <typename GraphType>
+class ColorReducer {
+public:
+    ColorReducer(GraphType const& g, Coloring &coloring, SizeType budget)
+        : mGraph(g)
+        , mColoring(coloring)
+        , mChains(g, coloring)
+        , mBudget(budget)
+    {
+    }
+
+    bool BudgetLeft() const noexcept
+    {
+        return mBudget > 0;
+    }
+
+    // Moves v of color top below it, directly or after one Kempe swap.
+    bool Recolor(Vertex v, ColorType top)
+    {
+        Collect(v, top);
+
+        // a color missing around v, the emptiest first
+        std::vector<ColorType> colors(top);
+        for (ColorType c = 0; c < top; ++c) {
+            colors[c] = c;
+        }
+        std::stable_sort(colors.begin(), colors.end(), [this](ColorType lhs, ColorType rhs) {
+            return mAround[lhs].size() < mAround[rhs].size();
+        });
+        if (mAround[colors[0]].empty()) {
+            mColoring[v] = colors[0];
+            return true;
+        }
+
+        for (auto a: colors) {
+            for (ColorType b = 0; b < top && mBudget > 0; ++b) {
+                if (a == b) {
+                    continue;
+                }
+                auto const moved = mChains.Swap(mAround[a], mAround[b], a, b, mBudget);
+                Spend(mChains.Explored());
+                if (moved) {
+                    mColoring[v] = a;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Swaps one chain next to v without any stop, the choice rotates with step.
+    void Shake(Vertex v, ColorType top, SizeType step)
+    {
+        Collect(v, top);
+
+        ColorType const a = step % top;
+        ColorType const b = (a + 1 + step / top % (top - 1)) % top;
+        if (mAround[a].empty()) {
+            Spend(1);
+            return;
+        }
+        Vertex const start = mAround[a][step % mAround[a].size()];
+        mChains.Swap({&start, 1}, {}, a, b, mBudget);
+        Spend(mChains.Explored());
+    }
+
+private:
+    // every attempt costs at least one move, so stuck passes end with the budget
+    void Spend(SizeType moves) noexcept
+    {
+        mBudget -= std::min(mBudget, std::max<SizeType>(moves, 1));
+    }
+
+    // neighbours of v grouped by color below top
+    void Collect(Vertex v, ColorType top)
+    {
+        mAround.resize(top);
+        for (auto &around: mAround) {
+            around.clear();
+        }
+        for (auto u: mGraph.Neighbours(v)) {
+            if (mColoring[u] < top) {
+                mAround[mColoring[u]].push_back(u);
+            }
+        }
+    }
+
+    GraphType const& mGraph;
+    Coloring &mColoring;
+    KempeChains<GraphType> mChains;
+    SizeType mBudget;
+
+    std::vector<std::vector<Vertex>> mAround;
+};
+
+template <typename GraphType>
+ColorType ReduceColors(
+    GraphType const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    SizeType budget, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    ColorReducer reducer(g, coloring, budget);
+
+    std::vector<Vertex> pending;
+    // two colors are left to a bipartiteness check, not to swaps
+    while (ncolors > std::max<ColorType>(lowerBound, 2)) {
+        ColorType const top = ncolors - 1;
+
+        pending.clear();
+        for (Vertex v = 0; v < g.NumVertices(); ++v) {
+            if (coloring[v] == top) {
+                pending.push_back(v);
+            }
+        }
+
+        // a recolored vertex may unblock the ones tried before, so passes repeat while
+        // they make progress and shake the stuck vertices otherwise
+        SizeType step = 0;
+        while (!pending.empty() && reducer.BudgetLeft()) {
+            auto const before = pending.size();
+            std::erase_if(pending, [&](Vertex v) {
+                return !timeLimitFunctor() && reducer.Recolor(v, top);
+            });
+            if (timeLimitFunctor()) {
+                return ncolors;
+            }
+            if (pending.size() == before) {
+                for (auto v: pending) {
+                    reducer.Shake(v, top, step++);
+                }
+            }
+        }
+
+        if (!pending.empty()) {
+            break;
+        }
+        --ncolors;
+    }
+
+    return ncolors;
+}
+} // namespace detail
+
+ColorType ReduceColors(
+    Graph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    SizeType budget, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::ReduceColors(g, coloring, ncolors, lowerBound, budget, timeLimitFunctor);
+}
+
+ColorType ReduceColors(
+    CompressedGraph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    SizeType budget, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::ReduceColors(g, coloring, ncolors, lowerBound, budget, timeLimitFunctor);
+}
+} // namespace solver::heuristics
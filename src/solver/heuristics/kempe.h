@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <span>
+
+#include "../compressed_graph.h"
+#include "../graph.h"
+
+namespace solver::heuristics {
+// Kempe chains: connected components of the subgraph induced by two colors.
+// Swapping the colors of a chain keeps the coloring valid.
+template <typename GraphType>
+class KempeChains {
+public:
+    KempeChains(GraphType const& g, Coloring &coloring)
+        : mGraph(g)
+        , mColoring(coloring)
+        , mStamps(g.NumVertices(), 0)
+    {
+    }
+
+    // Swaps colors a and b in the chains of starts unless they reach one of stops or
+    // hold more than limit vertices. Returns the number of recolored vertices, 0 if
+    // nothing was swapped.
+    SizeType Swap(
+        std::span<Vertex const> starts, std::span<Vertex const> stops,
+        ColorType a, ColorType b, SizeType limit
+    )
+    {
+        // a vertex is visited with stamp mStamp and a stop with mStamp + 1
+        if (mStamp >= UINT32_MAX - 2) {
+            std::fill(mStamps.begin(), mStamps.end(), 0);
+            mStamp = 0;
+        }
+        mStamp += 2;
+        for (auto s: stops) {
+            mStamps[s] = mStamp + 1;
+        }
+
+        mChain.clear();
+        for (auto s: starts) {
+            if (mStamps[s] == mStamp + 1) {
+                return 0;
+            }
+            if (mStamps[s] != mStamp) {
+                mStamps[s] = mStamp;
+                mChain.push_back(s);
+            }
+        }
+
+        for (size_t i = 0; i < mChain.size(); ++i) {
+            if (mChain.size() > limit) {
+                return 0;
+            }
+            for (auto u: mGraph.Neighbours(mChain[i])) {
+                if (mStamps[u] == mStamp || (mColoring[u] != a && mColoring[u] != b)) {
+                    continue;
+                }
+                if (mStamps[u] == mStamp + 1) {
+                    return 0;
+                }
+                mStamps[u] = mStamp;
+                mChain.push_back(u);
+            }
+        }
+        if (mChain.size() > limit) {
+            return 0;
+        }
+
+        for (auto v: mChain) {
+            mColoring[v] = mColoring[v] == a ? b : a;
+        }
+        return mChain.size();
+    }
+
+    // vertices walked by the last Swap, swapped or not
+    SizeType Explored() const noexcept
+    {
+        return mChain.size();
+    }
+
+private:
+    GraphType const& mGraph;
+    Coloring &mColoring;
+
+    std::vector<uint32_t> mStamps;
+    uint32_t mStamp { 0 };
+    std::vector<Vertex> mChain;
+};
+
+// chain vertices ReduceColors may walk per vertex of the graph
+inline SizeType constexpr KEMPE_MOVES_PER_VERTEX = 64;
+
+// Tries to empty the highest color classes of a valid coloring with ncolors colors,
+// down to lowerBound. A vertex of the top class is moved to a color free among its
+// neighbours, or to color a after swapping the (a, b) chains of its a-colored
+// neighbours; when a whole pass is stuck, chains around the stuck vertices are
+// swapped blindly to shake the neighbourhoods. Stops when the budget of walked chain
+// vertices or the time runs out. Returns the number of colors, the coloring stays
+// valid on every exit.
+ColorType ReduceColors(
+    Graph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    SizeType budget, TimeLimitFuncCRef timeLimitFunctor
+);
+ColorType ReduceColors(
+    CompressedGraph const& g, Coloring &coloring, ColorType ncolors, ColorType lowerBound,
+    SizeType budget, TimeLimitFuncCRef timeLimitFunctor
+);
+} // namespace solver::heuristics
@@ -0,0 +1,74 @@
+#include "planar5.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <bit>
+
+#include "smallest_last.h"
+#include "kempe.h"
+
+namespace solver::heuristics {
+namespace {
+ColorType constexpr NUM_COLORS = 5;
+
+// the time limit is checked once per this many colored vertices
+SizeType constexpr TIME_CHECK_PERIOD = 1024;
+} // namespace
+
+ColorType Planar5(Graph const& g, Embedding const& embedding, Coloring &coloring, TimeLimitFuncCRef timeLimitFunctor)
+{
+    auto const n = g.NumVertices();
+    auto const [order, degeneracy] = SmallestLastOrder(g);
+    if (degeneracy >= SizeType(NUM_COLORS + 1)) {
+        throw std::invalid_argument("PLANAR5 needs a planar graph");
+    }
+
+    coloring.assign(n, -1);
+    KempeChains chains(g, coloring);
+    SizeType constexpr NO_LIMIT = std::numeric_limits<SizeType>::max();
+    ColorType maxColor = 0;
+
+    // colored neighbours in clockwise order
+    std::vector<Vertex> around;
+
+    for (SizeType i = 0; i < n; ++i) {
+        if (i % TIME_CHECK_PERIOD == 0 && timeLimitFunctor()) {
+            return -1;
+        }
+
+        Vertex const v = order[n - 1 - i];
+        around.clear();
+        uint32_t used = 0;
+        for (auto const& e: embedding[v]) {
+            Vertex const u = e.source == v ? e.target : e.source;
+            if (coloring[u] >= 0) {
+                around.push_back(u);
+                used |= 1u << coloring[u];
+            }
+        }
+
+        if (std::popcount(used) == NUM_COLORS) {
+            // 5 neighbours with distinct colors, the 0-2 and 1-3 chains can't both close
+            for (size_t i = 0; i < 2; ++i) {
+                ColorType const freed = coloring[around[i]];
+                ColorType const other = coloring[around[i + 2]];
+                if (chains.Swap({&around[i], 1}, {&around[i + 2], 1}, freed, other, NO_LIMIT)) {
+                    used &= ~(1u << freed);
+                    break;
+                }
+            }
+            if (std::popcount(used) == NUM_COLORS) {
+                throw std::invalid_argument("PLANAR5 needs a planar graph");
+            }
+        }
+
+        ColorType c = std::countr_one(used);
+        coloring[v] = c;
+        maxColor = std::max(maxColor, c + 1);
+    }
+
+    return maxColor;
+}
+} // namespace solver::heuristics
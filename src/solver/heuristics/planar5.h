@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../embedding.h"
+#include "../graph.h"
+
+namespace solver::heuristics {
+// Certified 5-coloring of a planar graph. Vertices are colored in reverse
+// smallest-last order, so each one has at most 5 colored neighbours. When they use
+// all 5 colors, a Kempe chain swap in the style of Heawood's proof frees one: of the
+// two chains between opposite neighbours in the embedding rotation at most one can
+// connect its ends. A chain is walked to its end, which may be the whole graph, so the
+// worst case is O(n^2): O(n + m) plus up to two walks per vertex that meets 5 colors.
+// Throws std::invalid_argument if the graph is not 5-degenerate.
+// Returns -1 when the time limit is exceeded.
+ColorType Planar5(Graph const& g, Embedding const& embedding, Coloring &coloring, TimeLimitFuncCRef timeLimitFunctor);
+} // namespace solver::heuristics
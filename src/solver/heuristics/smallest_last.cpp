@@ -0,0 +1,129 @@
+#include "smallest_last.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace solver::heuristics {
+namespace detail {
+// the time limit is checked once per this many colored vertices
+SizeType constexpr TIME_CHECK_PERIOD = 1024;
+
+template <typename GraphType>
+DegeneracyOrder SmallestLastOrder(GraphType const& g)
+{
+    auto const n = g.NumVertices();
+
+    DegeneracyOrder result;
+    result.order.resize(n);
+    if (n == 0) {
+        return result;
+    }
+
+    // Batagelj-Zaversnik: vertices sorted by remaining degree in one array, bucket
+    // starts in start[], a vertex moves to the previous bucket by one swap.
+    std::vector<SizeType> degree(n);
+    SizeType maxDegree = 0;
+    for (Vertex v = 0; v < n; ++v) {
+        degree[v] = g.Degree(v);
+        maxDegree = std::max(maxDegree, degree[v]);
+    }
+
+    std::vector<SizeType> start(maxDegree + 2, 0);
+    for (Vertex v = 0; v < n; ++v) {
+        ++start[degree[v] + 1];
+    }
+    std::partial_sum(start.begin(), start.end(), start.begin());
+
+    auto &sorted = result.order;
+    std::vector<SizeType> position(n);
+    {
+        auto fill = start;
+        for (Vertex v = 0; v < n; ++v) {
+            position[v] = fill[degree[v]]++;
+            sorted[position[v]] = v;
+        }
+    }
+
+    for (SizeType i = 0; i < n; ++i) {
+        Vertex const v = sorted[i];
+        result.degeneracy = std::max(result.degeneracy, degree[v]);
+
+        for (auto u: g.Neighbours(v)) {
+            if (degree[u] <= degree[v]) {
+                continue;
+            }
+            // swap u with the first vertex of its bucket and shrink the bucket
+            auto const du = degree[u];
+            auto const pu = position[u];
+            auto const pw = start[du];
+            Vertex const w = sorted[pw];
+            if (u != w) {
+                std::swap(sorted[pu], sorted[pw]);
+                position[u] = pw;
+                position[w] = pu;
+            }
+            ++start[du];
+            --degree[u];
+        }
+    }
+
+    return result;
+}
+
+template <typename GraphType>
+ColorType SmallestLast(GraphType const& g, Coloring &coloring, SizeType &degeneracy, TimeLimitFuncCRef timeLimitFunctor)
+{
+    auto const n = g.NumVertices();
+    auto [order, d] = SmallestLastOrder(g);
+    degeneracy = d;
+
+    coloring.assign(n, -1);
+
+    // colors around the current vertex, stamped with its id + 1
+    std::vector<Vertex> seen(degeneracy + 1, 0);
+    ColorType maxColor = 0;
+
+    for (SizeType i = 0; i < n; ++i) {
+        if (i % TIME_CHECK_PERIOD == 0 && timeLimitFunctor()) {
+            return -1;
+        }
+
+        Vertex const v = order[n - 1 - i];
+        for (auto u: g.Neighbours(v)) {
+            if (coloring[u] >= 0) {
+                seen[coloring[u]] = v + 1;
+            }
+        }
+
+        ColorType c = 0;
+        while (seen[c] == v + 1) {
+            ++c;
+        }
+        coloring[v] = c;
+        maxColor = std::max(maxColor, c + 1);
+    }
+
+    return maxColor;
+}
+} // namespace detail
+
+DegeneracyOrder SmallestLastOrder(Graph const& g)
+{
+    return detail::SmallestLastOrder(g);
+}
+
+DegeneracyOrder SmallestLastOrder(CompressedGraph const& g)
+{
+    return detail::SmallestLastOrder(g);
+}
+
+ColorType SmallestLast(Graph const& g, Coloring &coloring, SizeType &degeneracy, TimeLimitFuncCRef timeLimitFunctor)
+{
+    return detail::SmallestLast(g, coloring, degeneracy, timeLimitFunctor);
+}
+
+ColorType SmallestLast(CompressedGraph const& g, Coloring &coloring, SizeType &degeneracy, TimeLimitFuncCRef timeLimitFunctor)
+{
+    return detail::SmallestLast(g, coloring, degeneracy, timeLimitFunctor);
+}
+} // namespace solver::heuristics
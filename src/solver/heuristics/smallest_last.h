@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "../compressed_graph.h"
+#include "../graph.h"
+
+namespace solver::heuristics {
+// Matula-Beck smallest-last ordering: vertices of minimum remaining degree are
+// removed one by one, order[0] is removed first. The largest degree seen at removal
+// is the degeneracy of the graph, at most 5 for planar graphs.
+struct DegeneracyOrder {
+    std::vector<Vertex> order;
+    SizeType degeneracy { 0 };
+};
+
+DegeneracyOrder SmallestLastOrder(Graph const& g);
+DegeneracyOrder SmallestLastOrder(CompressedGraph const& g);
+
+// Greedy coloring in reverse smallest-last order, uses at most degeneracy + 1 colors.
+// Runs in O(n + m), returns -1 when the time limit is exceeded.
+ColorType SmallestLast(Graph const& g, Coloring &coloring, SizeType &degeneracy, TimeLimitFuncCRef timeLimitFunctor);
+ColorType SmallestLast(CompressedGraph const& g, Coloring &coloring, SizeType &degeneracy, TimeLimitFuncCRef timeLimitFunctor);
+} // namespace solver::heuristics
@@ -0,0 +1,251 @@
+#include "evolutionary.h"
+
+#include <algorithm>
+#include <memory>
+#include <limits>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../heuristics/dsatur.h"
+#include "tabucol.h"
+
+namespace solver::local {
+namespace detail {
+// One published individual per thread. The owner is the only writer; readers copy
+// the colors and retry if the version changed meanwhile, so nobody ever blocks.
+class ElitePool {
+public:
+    ElitePool(size_t numSlots, SizeType n)
+        : mSlots(numSlots)
+    {
+        for (auto &slot: mSlots) {
+            slot.colors = std::make_unique<std::atomic<ColorType>[]>(n);
+        }
+        mSize = n;
+    }
+
+    size_t NumSlots() const noexcept
+    {
+        return mSlots.size();
+    }
+
+    void Publish(size_t i, Coloring const& coloring, SizeType conflicts)
+    {
+        auto &slot = mSlots[i];
+        auto const version = slot.version.load(std::memory_order_relaxed);
+        slot.version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (SizeType v = 0; v < mSize; ++v) {
+            slot.colors[v].store(coloring[v], std::memory_order_relaxed);
+        }
+        slot.conflicts.store(conflicts, std::memory_order_relaxed);
+        slot.version.store(version + 2, std::memory_order_release);
+    }
+
+    SizeType Conflicts(size_t i) const noexcept
+    {
+        return mSlots[i].conflicts.load(std::memory_order_relaxed);
+    }
+
+    // false if the slot is still empty
+    bool Read(size_t i, Coloring &coloring) const
+    {
+        auto const& slot = mSlots[i];
+        coloring.resize(mSize);
+        while (true) {
+            auto const before = slot.version.load(std::memory_order_acquire);
+            if (before == 0) {
+                return false;
+            }
+            if (before % 2 != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (SizeType v = 0; v < mSize; ++v) {
+                coloring[v] = slot.colors[v].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.version.load(std::memory_order_relaxed) == before) {
+                return true;
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> version { 0 };
+        std::atomic<SizeType> conflicts { std::numeric_limits<SizeType>::max() };
+        std::unique_ptr<std::atomic<ColorType>[]> colors;
+    };
+
+    std::vector<Slot> mSlots;
+    SizeType mSize { 0 };
+};
+
+// Greedy partition crossover: the largest class left in the parents in turn becomes
+// the next color of the child, the vertices left at the end get random colors.
+template <typename Generator>
+void Crossover(Coloring const& lhs, Coloring const& rhs, ColorType k, Coloring &child, Generator &gen)
+{
+    auto const n = lhs.size();
+    Coloring const *parents[2] = {&lhs, &rhs};
+
+    std::vector<std::vector<Vertex>> members[2];
+    std::vector<SizeType> left[2];
+    for (size_t p = 0; p < 2; ++p) {
+        members[p].assign(k, {});
+        left[p].assign(k, 0);
+        for (Vertex v = 0; v < n; ++v) {
+            members[p][(*parents[p])[v]].push_back(v);
+            ++left[p][(*parents[p])[v]];
+        }
+    }
+
+    child.assign(n, -1);
+    for (ColorType c = 0; c < k; ++c) {
+        size_t const p = c % 2;
+        auto const largest = std::max_element(left[p].begin(), left[p].end()) - left[p].begin();
+        for (auto v: members[p][largest]) {
+            if (child[v] != -1) {
+                continue;
+            }
+            child[v] = c;
+            --left[0][lhs[v]];
+            --left[1][rhs[v]];
+        }
+    }
+
+    for (auto &c: child) {
+        if (c == -1) {
+            c = gen() % k;
+        }
+    }
+}
+
+template <typename GraphType>
+bool EvolveColors(
+    GraphType const& g, Coloring &coloring, ColorType k, size_t numThreads,
+    uint64_t seed, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    auto const n = g.NumVertices();
+    uint64_t const tabuIterations = HEA_TABU_ITERATIONS + HEA_TABU_ITERATIONS_PER_VERTEX * n;
+
+    Coloring start = coloring;
+    DropClass(g, start, k);
+
+    ElitePool pool(numThreads, n);
+    std::atomic_bool stop = false;
+    std::atomic_bool solved = false;
+
+    // local searches of the other threads end as soon as one thread succeeds
+    TimeLimitFunc const stopped = [&stop, &timeLimitFunctor]() {
+        return stop || timeLimitFunctor();
+    };
+
+    // every valid k-coloring is claimed as soon as Tabucol returns it, the first one wins
+    auto claim = [&solved, &stop, &coloring](Coloring const& found) {
+        if (!solved.exchange(true)) {
+            coloring = found;
+        }
+        stop = true;
+    };
+
+    auto worker = [&](size_t t) {
+        std::mt19937_64 gen(seed + t * 0x9e3779b97f4a7c15ull);
+
+        // both parents start from the same coloring, Tabucol seeds set them apart
+        Coloring parents[2] = {start, start};
+        SizeType conflicts[2];
+        for (auto p: {0, 1}) {
+            conflicts[p] = Tabucol(g, parents[p], k, gen(), tabuIterations, stopped);
+            if (conflicts[p] == 0) {
+                claim(parents[p]);
+                return;
+            }
+        }
+
+        Coloring partner, child;
+        for (uint64_t generation = 0; generation < HEA_MAX_GENERATIONS && !stop; ++generation) {
+            auto const better = conflicts[0] <= conflicts[1] ? 0 : 1;
+            if (stopped()) {
+                stop = true;
+                return;
+            }
+            pool.Publish(t, parents[better], conflicts[better]);
+
+            Coloring const *other = &parents[1 - better];
+            if (pool.NumSlots() > 1 && generation % 2 == 1) {
+                auto const slot = (t + 1 + gen() % (pool.NumSlots() - 1)) % pool.NumSlots();
+                if (pool.Read(slot, partner)) {
+                    other = &partner;
+                }
+            }
+
+            Crossover(parents[better], *other, k, child, gen);
+            auto const childConflicts = Tabucol(g, child, k, gen(), tabuIterations, stopped);
+            if (childConflicts == 0) {
+                claim(child);
+                return;
+            }
+
+            auto const worse = 1 - better;
+            parents[worse].swap(child);
+            conflicts[worse] = childConflicts;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    return solved;
+}
+
+template <typename GraphType>
+ColorType Evolve(
+    GraphType const& g, Coloring &coloring, ColorType target, size_t numThreads,
+    uint64_t seed, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    auto ncolors = heuristics::DSatur(g, coloring, DSATUR_BUCKET, timeLimitFunctor);
+    if (ncolors == -1) {
+        return -1;
+    }
+
+    numThreads = std::max<size_t>(numThreads, 1);
+    while (ncolors > std::max<ColorType>(target, 1)) {
+        ColorType const k = ncolors - 1;
+        if (!EvolveColors(g, coloring, k, numThreads, seed + k, timeLimitFunctor)) {
+            break;
+        }
+        ncolors = k;
+    }
+
+    return ncolors;
+}
+} // namespace detail
+
+ColorType Evolve(
+    Graph const& g, Coloring &coloring, ColorType target, size_t numThreads,
+    uint64_t seed, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::Evolve(g, coloring, target, numThreads, seed, timeLimitFunctor);
+}
+
+ColorType Evolve(
+    CompressedGraph const& g, Coloring &coloring, ColorType target, size_t numThreads,
+    uint64_t seed, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::Evolve(g, coloring, target, numThreads, seed, timeLimitFunctor);
+}
+} // namespace solver::local
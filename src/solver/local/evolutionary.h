@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "../compressed_graph.h"
+#include "../graph.h"
+
+namespace solver::local {
+// generations of one worker, per number of colors tried
+inline uint64_t constexpr HEA_MAX_GENERATIONS = 2'000;
+
+// Tabucol iterations per generation: HEA_TABU_ITERATIONS + HEA_TABU_ITERATIONS_PER_VERTEX * n
+inline uint64_t constexpr HEA_TABU_ITERATIONS = 10'000;
+inline uint64_t constexpr HEA_TABU_ITERATIONS_PER_VERTEX = 4;
+
+// Hybrid evolutionary coloring (Galinier, Hao). Every thread keeps two parents,
+// crosses them by greedy partition crossover (GPX) and improves the child with
+// Tabucol; the child replaces the worse parent. Threads publish their best individual
+// to a lock-free pool of seqlock slots, and every other generation one parent is
+// read from the slot of another thread. Starts from a DSATUR coloring and asks for
+// one color less after every success, down to target colors, until a failure or the
+// time limit. Returns the number of colors of the valid coloring left in coloring,
+// -1 if DSATUR ran out of time. Only single-threaded runs are reproducible.
+ColorType Evolve(
+    Graph const& g, Coloring &coloring, ColorType target, size_t numThreads,
+    uint64_t seed, TimeLimitFuncCRef timeLimitFunctor
+);
+ColorType Evolve(
+    CompressedGraph const& g, Coloring &coloring, ColorType target, size_t numThreads,
+    uint64_t seed, TimeLimitFuncCRef timeLimitFunctor
+);
+} // namespace solver::local
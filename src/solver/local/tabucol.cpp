@@ -0,0 +1,228 @@
+#include "tabucol.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../heuristics/dsatur.h"
+
+namespace solver::local {
+namespace detail {
+// tenure = random [0, TENURE_RANDOM) + TENURE_FACTOR * conflicting vertices
+uint32_t constexpr TENURE_RANDOM = 10;
+double constexpr TENURE_FACTOR = 0.6;
+
+// the time limit is checked once per this many iterations
+uint64_t constexpr TIME_CHECK_PERIOD = 1024;
+
+// Set of vertices with at least one conflict, swap-with-last removal.
+class ConflictSet {
+public:
+    static uint32_t constexpr NONE = UINT32_MAX;
+
+    void Init(SizeType n)
+    {
+        mItems.clear();
+        mPosition.assign(n, NONE);
+    }
+
+    void Set(Vertex v, bool conflicting)
+    {
+        if (conflicting && mPosition[v] == NONE) {
+            mPosition[v] = mItems.size();
+            mItems.push_back(v);
+        } else if (!conflicting && mPosition[v] != NONE) {
+            Vertex const last = mItems.back();
+            mItems[mPosition[v]] = last;
+            mPosition[last] = mPosition[v];
+            mItems.pop_back();
+            mPosition[v] = NONE;
+        }
+    }
+
+    std::vector<Vertex> const& Items() const noexcept
+    {
+        return mItems;
+    }
+
+private:
+    std::vector<Vertex> mItems;
+    std::vector<uint32_t> mPosition;
+};
+
+template <typename GraphType>
+SizeType Tabucol(
+    GraphType const& g, Coloring &coloring, ColorType k, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    auto const n = g.NumVertices();
+    std::mt19937_64 gen(seed);
+
+    // gamma[v * k + c]: neighbours of v colored c
+    std::vector<uint32_t> gamma(n * k, 0);
+    // tabu[v * k + c]: first iteration when v may take c again
+    std::vector<uint64_t> tabu(n * k, 0);
+
+    int64_t conflicts = 0;
+    for (Vertex v = 0; v < n; ++v) {
+        for (auto u: g.Neighbours(v)) {
+            ++gamma[v * k + coloring[u]];
+        }
+        conflicts += gamma[v * k + coloring[v]];
+    }
+    conflicts /= 2;
+
+    ConflictSet conflicting;
+    conflicting.Init(n);
+    for (Vertex v = 0; v < n; ++v) {
+        conflicting.Set(v, gamma[v * k + coloring[v]] > 0);
+    }
+
+    int64_t best = conflicts;
+    std::vector<std::pair<Vertex, ColorType>> moves;
+
+    for (uint64_t it = 0; conflicts > 0 && it < maxIterations; ++it) {
+        if (it % TIME_CHECK_PERIOD == 0 && timeLimitFunctor()) {
+            break;
+        }
+
+        // best non-tabu move over the conflicting vertices, ties broken at random
+        int64_t bestDelta = INT64_MAX;
+        moves.clear();
+        for (auto v: conflicting.Items()) {
+            auto const *row = gamma.data() + v * k;
+            int64_t const current = row[coloring[v]];
+            for (ColorType c = 0; c < k; ++c) {
+                if (c == coloring[v]) {
+                    continue;
+                }
+                int64_t const delta = int64_t(row[c]) - current;
+                bool const aspiration = conflicts + delta < best;
+                if (tabu[v * k + c] > it && !aspiration) {
+                    continue;
+                }
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    moves.clear();
+                }
+                if (delta == bestDelta) {
+                    moves.emplace_back(v, c);
+                }
+            }
+        }
+
+        if (moves.empty()) {
+            continue;
+        }
+
+        auto const [v, c] = moves[gen() % moves.size()];
+        ColorType const old = coloring[v];
+
+        coloring[v] = c;
+        conflicts += bestDelta;
+        for (auto u: g.Neighbours(v)) {
+            --gamma[u * k + old];
+            ++gamma[u * k + c];
+            conflicting.Set(u, gamma[u * k + coloring[u]] > 0);
+        }
+        conflicting.Set(v, gamma[v * k + c] > 0);
+
+        auto const tenure = gen() % TENURE_RANDOM + uint64_t(TENURE_FACTOR * conflicting.Items().size());
+        tabu[v * k + old] = it + 1 + tenure;
+
+        best = std::min(best, conflicts);
+    }
+
+    return conflicts;
+}
+
+template <typename GraphType>
+void DropClass(GraphType const& g, Coloring &coloring, ColorType k)
+{
+    std::vector<uint32_t> count(k);
+    for (Vertex v = 0; v < g.NumVertices(); ++v) {
+        if (coloring[v] != k) {
+            continue;
+        }
+        std::fill(count.begin(), count.end(), 0);
+        for (auto u: g.Neighbours(v)) {
+            if (coloring[u] < k) {
+                ++count[coloring[u]];
+            }
+        }
+        coloring[v] = std::min_element(count.begin(), count.end()) - count.begin();
+    }
+}
+
+template <typename GraphType>
+ColorType TabuSearch(
+    GraphType const& g, Coloring &coloring, ColorType target, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    auto ncolors = heuristics::DSatur(g, coloring, DSATUR_BUCKET, timeLimitFunctor);
+    if (ncolors == -1) {
+        return -1;
+    }
+
+    Coloring candidate;
+    while (ncolors > std::max<ColorType>(target, 1)) {
+        ColorType const k = ncolors - 1;
+
+        candidate = coloring;
+        DropClass(g, candidate, k);
+
+        if (Tabucol(g, candidate, k, seed + k, maxIterations, timeLimitFunctor) != 0) {
+            break;
+        }
+        coloring.swap(candidate);
+        ncolors = k;
+    }
+
+    return ncolors;
+}
+} // namespace detail
+
+SizeType Tabucol(
+    Graph const& g, Coloring &coloring, ColorType k, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::Tabucol(g, coloring, k, seed, maxIterations, timeLimitFunctor);
+}
+
+SizeType Tabucol(
+    CompressedGraph const& g, Coloring &coloring, ColorType k, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::Tabucol(g, coloring, k, seed, maxIterations, timeLimitFunctor);
+}
+
+void DropClass(Graph const& g, Coloring &coloring, ColorType k)
+{
+    detail::DropClass(g, coloring, k);
+}
+
+void DropClass(CompressedGraph const& g, Coloring &coloring, ColorType k)
+{
+    detail::DropClass(g, coloring, k);
+}
+
+ColorType TabuSearch(
+    Graph const& g, Coloring &coloring, ColorType target, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::TabuSearch(g, coloring, target, seed, maxIterations, timeLimitFunctor);
+}
+
+ColorType TabuSearch(
+    CompressedGraph const& g, Coloring &coloring, ColorType target, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::TabuSearch(g, coloring, target, seed, maxIterations, timeLimitFunctor);
+}
+} // namespace solver::local
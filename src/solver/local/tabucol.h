@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../compressed_graph.h"
+#include "../graph.h"
+
+namespace solver::local {
+// iterations of one Tabucol run, per number of colors tried
+inline uint64_t constexpr TABUCOL_MAX_ITERATIONS = 10'000'000;
+
+// Tabucol (Hertz, de Werra): moves one conflicting vertex per iteration to the color
+// with the fewest conflicts, using a gamma table of neighbour counts per vertex and
+// color that is updated incrementally. A move back to the old color is tabu for a
+// tenure growing with the number of conflicting vertices, unless it beats the best
+// state seen. coloring must hold colors in [0, k). Returns the number of conflicting
+// edges left in coloring, it is a valid coloring if there are none.
+SizeType Tabucol(
+    Graph const& g, Coloring &coloring, ColorType k, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+);
+SizeType Tabucol(
+    CompressedGraph const& g, Coloring &coloring, ColorType k, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+);
+
+// Moves the vertices of color k to the colors in [0, k) least used around them.
+void DropClass(Graph const& g, Coloring &coloring, ColorType k);
+void DropClass(CompressedGraph const& g, Coloring &coloring, ColorType k);
+
+// Starts from a DSATUR coloring and asks Tabucol for one color less after dropping the
+// top class, down to target colors or to the first failure. Returns the number of
+// colors of the valid coloring left in coloring, -1 if DSATUR ran out of time.
+ColorType TabuSearch(
+    Graph const& g, Coloring &coloring, ColorType target, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+);
+ColorType TabuSearch(
+    CompressedGraph const& g, Coloring &coloring, ColorType target, uint64_t seed,
+    uint64_t maxIterations, TimeLimitFuncCRef timeLimitFunctor
+);
+} // namespace solver::local
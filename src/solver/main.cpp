@@ -1,30 +1,49 @@
-#include <boost/range/iterator_range_core.hpp>
-
 #include <boost/program_options.hpp>
 
 #include <boost/timer/timer.hpp>
 
+#include <type_traits>
 #include <filesystem>
+#include <algorithm>
 #include <stdexcept>
+#include <exception>
 #include <iostream>
 #include <optional>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
-#include <sstream>
-#include <fstream>
+#include <numeric>
 #include <thread>
 #include <memory>
 #include <atomic>
 #include <chrono>
 #include <string>
+#include <utility>
+#include <vector>
 #include <limits>
 #include <array>
-
-#include <dimacs_coloring_io.h>
-
+#include <set>
+
+#include <adjacency_arrays.h>
+#include <dimacs_parser.h>
+#include <mapped_file.h>
+#include <dshu_graph.h>
+#include <dshu_v2.h>
+
+#include "parallel/jones_plassmann.h"
+#include "heuristics/iterated_greedy.h"
+#include "heuristics/smallest_last.h"
+#include "heuristics/planar5.h"
+#include "local/evolutionary.h"
 #include "heuristics/dsatur.h"
+#include "heuristics/kempe.h"
+#include "local/tabucol.h"
 #include "exact/dsatur.h"
+#include "compressed_graph.h"
+#include "decomposition.h"
+#include "reordering.h"
+#include "reduction.h"
+#include "embedding.h"
 #include "coloring.h"
 #include "config.h"
 #include "clique.h"
@@ -35,7 +54,24 @@ namespace fs = std::filesystem;
 struct Parameters {
     std::chrono::seconds timeLimit { std::numeric_limits<int64_t>::max() };
     std::optional<fs::path> inputPath { std::nullopt };
-    solver::Config config;
+    solver::Config config { solver::DSATUR };
+    solver::Ordering ordering { solver::Ordering::NONE };
+    bool compressed { false };
+    bool kempe { false };
+    solver::Improvement improvement { solver::Improvement::NONE };
+    std::chrono::seconds improveTime { 10 };
+    size_t numThreads { std::max(1u, std::thread::hardware_concurrency()) };
+    uint64_t seed { 0 };
+    std::vector<solver::Config> portfolio;
+    solver::SizeType peel { 0 };
+    bool decompose { false };
+    solver::SizeType pieceSize { 0 };
+
+    // whether config runs alone or in the portfolio
+    bool Runs(solver::Config c) const
+    {
+        return portfolio.empty() ? config == c : std::ranges::find(portfolio, c) != portfolio.end();
+    }
 };
 
 namespace po = boost::program_options;
@@ -45,7 +81,7 @@ bool ProcessCommandLine(int32_t argc, char **argv, Parameters &params)
     po::options_description desc("Options");
     desc.add_options()
         ("help,h", "Produce help message.")
-        ("input,i", po::value<fs::path>()->composing(), "Path to DIMACS problem.")
+        ("input,i", po::value<fs::path>()->composing(), "Path to DIMACS problem or DSHU v1/v2 binary graph (detected by magic).")
         ("config,c", po::value<solver::Config>(&params.config),
             "Coloring implementation. Possible values:"
             " DSATUR,"
@@ -53,11 +89,54 @@ bool ProcessCommandLine(int32_t argc, char **argv, Parameters &params)
             " DSATUR_FIBONACCI_HEAP,"
             " DSATUR_SEWEL,"
             " DSATUR_PASS,"
+            " DSATUR_BUCKET,"
+            " DSATUR_DARY_HEAP,"
 
             " BNB_DSATUR,"
             " BNB_DSATUR_SEWELL,"
-            " BNB_DSATUR_PASS.")
-        ("time-limit,t", po::value<int64_t>(), "Time limit");
+            " BNB_DSATUR_PASS,"
+
+            " PARALLEL_JP,"
+
+            " SMALLEST_LAST,"
+
+            " PLANAR5 (planar graphs only, O(n^2) in the worst case),"
+
+            " TABUCOL,"
+            " HEA (hybrid evolutionary, uses --threads).")
+        ("portfolio", po::value<std::vector<solver::Config>>(&params.portfolio)->multitoken(),
+            "Race several configs, each on its own thread, instead of --config."
+            " They share the best color count: BnB configs prune with it and everybody stops"
+            " once it meets the clique bound or the bound of a BnB run that searched to the end. The best coloring at the end wins.")
+        ("reorder,r", po::value<solver::Ordering>(&params.ordering),
+            "Relabel vertices before solving for better memory locality. Possible values:"
+            " none (default),"
+            " bfs (Cuthill-McKee),"
+            " degree,"
+            " hilbert (needs coordinates from a DSHU v2 input).")
+        ("peel", po::value<solver::SizeType>(&params.peel),
+            "Remove vertices of degree below this value one by one, color the kernel that is left"
+            " and put the removed vertices back greedily. 0 disables it (default).")
+        ("decompose", po::bool_switch(&params.decompose),
+            "Split the graph into connected components and their biconnected blocks, color the blocks"
+            " on --threads workers and join the colorings at the cut vertices.")
+        ("divide", po::value<solver::SizeType>(&params.pieceSize),
+            "Cut the graph along BFS levels until no piece has more vertices than this value, color"
+            " the pieces on --threads workers, then the cut levels first fit and repair them with"
+            " Kempe chains. Meant for huge planar graphs. 0 disables it (default).")
+        ("compressed,z", po::bool_switch(&params.compressed),
+            "Keep the graph delta-encoded in memory. Skips the clique lower bound.")
+        ("improve", po::value<solver::Improvement>(&params.improvement),
+            "Improve heuristic colorings. Possible values:"
+            " none (default),"
+            " iterated-greedy (Culberson passes over permuted color classes).")
+        ("improve-time", po::value<int64_t>(), "Time budget of --improve in seconds (default: 10).")
+        ("kempe,k", po::bool_switch(&params.kempe),
+            "Try to drop the highest colors of a heuristic coloring with Kempe chain swaps."
+            " BnB configs run a DSATUR_BUCKET coloring through it first and search only if it keeps more than 4 colors.")
+        ("time-limit,t", po::value<int64_t>(), "Time limit")
+        ("threads,j", po::value<size_t>(&params.numThreads), "Number of worker threads (default: all cores).")
+        ("seed,s", po::value<uint64_t>(&params.seed), "Seed of the randomized configs (default: 0).");
 
     po::variables_map vm;
     try {
@@ -82,24 +161,43 @@ bool ProcessCommandLine(int32_t argc, char **argv, Parameters &params)
         params.timeLimit = std::chrono::seconds(vm["time-limit"].as<int64_t>());
     }
 
+    if (vm.contains("improve-time")) {
+        params.improveTime = std::chrono::seconds(vm["improve-time"].as<int64_t>());
+    }
+
     try {
         po::notify(vm);
     } catch(std::exception& e) {
         std::cerr << "\033[31m" << "Error: " << e.what() << "\033[0m" << std::endl;
         return false;
     }
-    return true;
-}
 
-std::unique_ptr<std::istream> CreateIstream(std::string&& source, bool fromFile) {
-    if (fromFile) {
-        auto ptr = std::make_unique<std::ifstream>(std::string(source));
-        if (!ptr->is_open()) {
-            throw std::runtime_error("Unable to open file for reading");
-        }
-        return ptr;
+    if (!vm.contains("config") && params.portfolio.empty()) {
+        std::cerr << "\033[31m" << "Error: either --config or --portfolio is required" << "\033[0m" << std::endl;
+        return false;
+    }
+
+    if (params.decompose && params.pieceSize > 0) {
+        std::cerr << "\033[31m" << "Error: --decompose and --divide exclude each other" << "\033[0m" << std::endl;
+        return false;
     }
-    return std::make_unique<std::stringstream>(source);
+
+    bool const splits = params.decompose || params.pieceSize > 0;
+    if (splits && (params.compressed || !params.portfolio.empty())) {
+        std::cerr << "\033[31m" << "Error: --decompose and --divide need the CSR graph and a single --config" << "\033[0m" << std::endl;
+        return false;
+    }
+
+    if (splits && params.Runs(solver::PLANAR5)) {
+        std::cerr << "\033[31m" << "Error: PLANAR5 needs the planar embedding of the whole graph, drop --decompose and --divide" << "\033[0m" << std::endl;
+        return false;
+    }
+
+    if (params.Runs(solver::PLANAR5) && params.compressed) {
+        std::cerr << "\033[31m" << "Error: PLANAR5 needs the planar embedding of the CSR graph, drop --compressed" << "\033[0m" << std::endl;
+        return false;
+    }
+    return true;
 }
 
 auto ToSeconds(boost::timer::cpu_times const& times)
@@ -117,34 +215,105 @@ int32_t main(int32_t argc, char **argv)
     }
 
     solver::Graph g;
+    std::optional<solver::CompressedGraph> compressed;
+    std::vector<solver::Coordinate> coordinates;
 
-    std::unique_ptr<std::istream> streamPtr;
     try {
+        // stdin can't be mapped, so it is read once in large chunks
+        std::optional<utils::MappedFile> file;
+        std::string input;
         if (params.inputPath) {
-            streamPtr = CreateIstream(*params.inputPath, true);
+            file.emplace(*params.inputPath);
+        } else {
+            input = utils::ReadAll(std::cin);
+        }
+
+        // every format is packed into the same CSR arrays
+        if (file && utils::DshuGraph::IsDshu(file->View())) {
+            g = solver::Graph(utils::AdjacencyArrays::FromAdjacency(utils::DshuGraph(std::move(*file))));
+        } else if (file && utils::DshuV2::IsDshuV2(file->View())) {
+            utils::DshuV2Graph dshu(std::move(*file));
+            // records are already sorted, so they are re-encoded without the CSR step
+            if (params.compressed && params.ordering == solver::Ordering::NONE && params.peel == 0) {
+                compressed = solver::CompressedGraph::Encode(dshu);
+            } else {
+                g = solver::Graph(utils::AdjacencyArrays::FromAdjacency(dshu));
+            }
+            if (dshu.HasCoordinates()) {
+                coordinates.resize(dshu.NumVertices());
+                for (uint64_t v = 0; v < dshu.NumVertices(); ++v) {
+                    coordinates[v] = dshu.Coordinates(v);
+                }
+            }
         } else {
-            std::ostringstream oss;
-            oss << std::cin.rdbuf();
-            streamPtr = CreateIstream(oss.str(), false);
+            auto problem = utils::ParseDimacs(file ? file->View() : std::string_view(input), params.numThreads);
+            g = solver::Graph(utils::AdjacencyArrays::FromEdges(problem.numVertices, problem.edges));
         }
     } catch(std::exception& e) {
         std::cerr << "\033[31m" << "Error: " << e.what() << "\033[0m" << std::endl;
         return EXIT_FAILURE;
     }
 
-    using DimacsIO = utils::DimacsColoringIO<solver::Graph>;
-    DimacsIO::Read(g, boost::get(&solver::VertexProperty::index, g), *streamPtr);
+    if (params.ordering == solver::Ordering::HILBERT && coordinates.size() != g.NumVertices()) {
+        std::cout << "[WARNING] no vertex coordinates, using bfs order" << std::endl;
+        params.ordering = solver::Ordering::BFS;
+    }
 
-    {
-        int32_t edgeIndex = 0;
-        auto edgeIndexMap = boost::get(&solver::EdgeProperty::index, g);
-        for (auto e: boost::make_iterator_range(boost::edges(g))) {
-            edgeIndexMap[e] = edgeIndex++;
-        }
+    // order[newId] == oldId, colors are mapped back before the output
+    solver::Permutation order;
+    std::optional<solver::Embedding> embedding;
+    solver::ColorType cliqueLB = -1;
+    if (params.ordering == solver::Ordering::BFS) {
+        order = solver::CuthillMcKeeOrder(g);
+    } else if (params.ordering == solver::Ordering::DEGREE) {
+        order = solver::DegreeOrder(g);
+    } else if (params.ordering == solver::Ordering::HILBERT) {
+        order = solver::HilbertOrder(coordinates);
+    }
+    coordinates = {};
+
+    if (!order.empty()) {
+        g = solver::Relabel(g, order);
+    }
+
+    // the kernel is solved in place of the graph, its coloring is extended back before the output
+    std::optional<solver::Kernel> kernel;
+    solver::Graph full;
+    if (params.peel > 0) {
+        kernel = solver::PeelLowDegree(g, params.peel);
+        full = std::move(g);
+        g = std::move(kernel->graph);
+        std::cout << "Peeled " << kernel->peeled.size() << " vertices of degree < " << params.peel
+            << ", kernel: " << g.NumVertices() << " vertices, " << g.NumEdges() << " edges" << std::endl;
     }
 
-    auto LB = solver::FindClique(g);
-    std::cout << "Clique LB=" << LB << std::endl;
+    if (params.compressed) {
+        if (!compressed) {
+            compressed = solver::CompressedGraph::Encode(g);
+        }
+
+        // offsets and targets of the CSR graph that is not built
+        size_t const csrSize = (compressed->NumVertices() + 1) * sizeof(uint64_t)
+            + 2 * compressed->NumEdges() * sizeof(solver::Vertex);
+        size_t const compressedSize = compressed->MemoryUsage();
+        std::cout << "Graph memory: " << compressedSize << " bytes compressed, " << csrSize << " bytes as CSR, "
+            << csrSize - std::min(csrSize, compressedSize) << " bytes saved" << std::endl;
+
+        g = {};
+        std::cout << "[WARNING] clique search needs the CSR graph, skipped" << std::endl;
+    } else {
+        embedding = solver::PlanarEmbedding(g);
+        if (!embedding) {
+            std::cout << "[WARNING] not a planar graph" << std::endl;
+        }
+        cliqueLB = embedding ? solver::FindClique(g, *embedding) : -1;
+        std::cout << "Clique LB=" << cliqueLB << std::endl;
+
+        // only PLANAR5 needs the embedding later
+        if (!params.Runs(solver::PLANAR5)) {
+            embedding.reset();
+        }
+    }
 
     std::atomic_bool isJobDone = false;
     boost::timer::cpu_timer jobTimer;
@@ -166,18 +335,315 @@ int32_t main(int32_t argc, char **argv)
     });
 
     solver::ColorType ncolors;
+    solver::Coloring colors;
     boost::timer::cpu_timer t;
 
     auto timeLimitFunctor = [&t, &params]() {
         return ToSeconds(t.elapsed()) > params.timeLimit;
     };
 
-    if (params.config < solver::__DSATUR_BOUND) {
-        ncolors = solver::heuristics::DSatur(g, params.config, timeLimitFunctor);
-    } else if (params.config < solver::__BNB_DSATUR_BOUND) {
-        ncolors = solver::exact::DSatur(g, params.config, timeLimitFunctor);
-    } else {
-        assert("We should never be here.");
+    // heuristic colorings go through --improve and then --kempe; subgraph runs are not
+    // verbose, their progress lines would flood the output
+    auto reduce = [&params, &cliqueLB](
+        auto const& graph, solver::Coloring &colors, solver::ColorType ncolors, solver::TimeLimitFuncCRef timeLimitFunctor,
+        bool verbose
+    ) {
+        if (ncolors != -1 && params.improvement == solver::Improvement::ITERATED_GREEDY) {
+            boost::timer::cpu_timer improveTimer;
+            auto const stopFunctor = [&improveTimer, &params, &timeLimitFunctor]() {
+                return ToSeconds(improveTimer.elapsed()) >= params.improveTime || timeLimitFunctor();
+            };
+            ncolors = solver::heuristics::IteratedGreedy(graph, colors, ncolors, cliqueLB, params.seed, stopFunctor, verbose);
+        }
+        if (!params.kempe || ncolors == -1) {
+            return ncolors;
+        }
+        auto const budget = solver::heuristics::KEMPE_MOVES_PER_VERTEX * graph.NumVertices();
+        auto const reduced = solver::heuristics::ReduceColors(graph, colors, ncolors, cliqueLB, budget, timeLimitFunctor);
+        if (verbose) {
+            std::cout << "Kempe chains: K=" << ncolors << " -> K=" << reduced << std::endl;
+        }
+        return reduced;
+    };
+
+    // -1 means no coloring: the time ran out, or BnB searched to the end without finding one
+    // below its bound, which it then stores in lowerBound
+    auto solve = [&params, &embedding, &cliqueLB, &reduce](
+        auto const& graph, solver::Config config, solver::Coloring &colors,
+        solver::TimeLimitFuncCRef timeLimitFunctor, solver::Incumbent *incumbent, solver::ColorType *lowerBound,
+        bool verbose
+    ) -> solver::ColorType {
+        if (config < solver::__DSATUR_BOUND) {
+            return reduce(graph, colors, solver::heuristics::DSatur(graph, colors, config, timeLimitFunctor), timeLimitFunctor, verbose);
+        } else if (config < solver::__BNB_DSATUR_BOUND) {
+            // with --kempe BnB runs only if a reduced heuristic coloring misses the clique bound,
+            // and then only looks for colorings with fewer colors than that one
+            if (params.kempe) {
+                auto const ncolors = reduce(graph, colors, solver::heuristics::DSatur(graph, colors, solver::DSATUR_BUCKET, timeLimitFunctor), timeLimitFunctor, verbose);
+                if (ncolors != -1 && ncolors <= cliqueLB) {
+                    if (verbose) {
+                        std::cout << "BnB skipped" << std::endl;
+                    }
+                    return ncolors;
+                }
+                if (ncolors != -1) {
+                    // a shared incumbent learns the heuristic coloring, a local one carries it otherwise
+                    solver::Incumbent seed = ncolors;
+                    if (incumbent) {
+                        auto current = incumbent->load(std::memory_order_relaxed);
+                        while (ncolors < current && !incumbent->compare_exchange_weak(current, ncolors)) {
+                        }
+                    }
+                    auto heuristic = colors;
+                    auto const answer = solver::exact::DSatur(graph, colors, config, timeLimitFunctor, incumbent ? incumbent : &seed, lowerBound);
+                    if (answer < solver::exact::BNB_COLOR_BOUND) {
+                        return answer;
+                    }
+                    colors = std::move(heuristic);
+                    return ncolors;
+                }
+            }
+            auto const answer = solver::exact::DSatur(graph, colors, config, timeLimitFunctor, incumbent, lowerBound);
+            return answer < solver::exact::BNB_COLOR_BOUND ? answer : -1;
+        } else if (config < solver::__PARALLEL_BOUND) {
+            return reduce(graph, colors, solver::parallel::JonesPlassmann(graph, colors, params.numThreads, params.seed, timeLimitFunctor), timeLimitFunctor, verbose);
+        } else if (config < solver::__GREEDY_BOUND) {
+            solver::SizeType degeneracy;
+            auto const ncolors = solver::heuristics::SmallestLast(graph, colors, degeneracy, timeLimitFunctor);
+            if (verbose) {
+                std::cout << "Degeneracy=" << degeneracy << std::endl;
+            }
+            return reduce(graph, colors, ncolors, timeLimitFunctor, verbose);
+        } else if (config < solver::__PLANAR_BOUND) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(graph)>, solver::Graph>) {
+                if (!embedding) {
+                    throw std::invalid_argument("PLANAR5 needs a planar graph");
+                }
+                return reduce(graph, colors, solver::heuristics::Planar5(graph, *embedding, colors, timeLimitFunctor), timeLimitFunctor, verbose);
+            } else {
+                throw std::invalid_argument("PLANAR5 needs the CSR graph");
+            }
+        } else if (config < solver::__LOCAL_SEARCH_BOUND) {
+            // the clique is the best possible answer, 4 colors are the target without it
+            auto const target = cliqueLB > 0 ? cliqueLB : 4;
+            auto const ncolors = config == solver::TABUCOL
+                ? solver::local::TabuSearch(
+                    graph, colors, target, params.seed, solver::local::TABUCOL_MAX_ITERATIONS, timeLimitFunctor
+                )
+                : solver::local::Evolve(graph, colors, target, params.numThreads, params.seed, timeLimitFunctor);
+            if (verbose && ncolors > target) {
+                std::cout << "Local search failed to reach K=" << target << std::endl;
+            }
+            return ncolors;
+        } else {
+            assert("We should never be here.");
+            return -1;
+        }
+    };
+    // --portfolio: one thread per config over the shared graph, the best valid coloring wins
+    auto race = [&params, &cliqueLB, &timeLimitFunctor, &solve, &colors](auto const& graph) -> solver::ColorType {
+        auto const numWorkers = params.portfolio.size();
+
+        solver::Incumbent incumbent = std::numeric_limits<solver::ColorType>::max();
+        // the clique or the bound of a BnB run that searched to the end
+        std::atomic<solver::ColorType> lowerBound = cliqueLB;
+
+        // everybody stops at the deadline or when the best coloring is proven optimal
+        solver::TimeLimitFunc const stopFunctor = [&incumbent, &lowerBound, &timeLimitFunctor]() {
+            return incumbent.load(std::memory_order_relaxed) <= lowerBound.load(std::memory_order_relaxed)
+                || timeLimitFunctor();
+        };
+
+        std::vector<solver::Coloring> colorings(numWorkers);
+        std::vector<solver::ColorType> results(numWorkers, -1);
+        std::vector<solver::ColorType> proofs(numWorkers, -1);
+        std::vector<std::exception_ptr> errors(numWorkers);
+
+        auto worker = [&](size_t i) {
+            auto const config = params.portfolio[i];
+            try {
+                auto &proven = proofs[i];
+                auto ncolors = solve(graph, config, colorings[i], stopFunctor, &incumbent, &proven, true);
+
+                // a BnB run without a coloring may still have proven a bound
+                if (ncolors != -1) {
+                    results[i] = ncolors;
+                    auto current = incumbent.load(std::memory_order_relaxed);
+                    while (ncolors < current && !incumbent.compare_exchange_weak(current, ncolors)) {
+                    }
+                }
+                auto current = lowerBound.load(std::memory_order_relaxed);
+                while (proven > current && !lowerBound.compare_exchange_weak(current, proven)) {
+                }
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < numWorkers; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        for (auto const& error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        size_t best = numWorkers;
+        for (size_t i = 0; i < numWorkers; ++i) {
+            if (results[i] == -1 && proofs[i] != -1) {
+                std::cout << "Portfolio " << params.portfolio[i] << ": no coloring below K=" << proofs[i] << std::endl;
+                continue;
+            }
+            if (results[i] == -1) {
+                std::cout << "Portfolio " << params.portfolio[i] << ": stopped" << std::endl;
+                continue;
+            }
+            std::cout << "Portfolio " << params.portfolio[i] << ": K=" << results[i] << std::endl;
+            if (best == numWorkers || results[i] < results[best]) {
+                best = i;
+            }
+        }
+        if (best == numWorkers) {
+            return -1;
+        }
+
+        bool const optimal = results[best] <= lowerBound;
+        std::cout << "Portfolio winner: " << params.portfolio[best] << (optimal ? " (optimal)" : "") << std::endl;
+        colors = std::move(colorings[best]);
+        return results[best];
+    };
+
+    // independent subgraphs are colored by a pool of workers, largest first;
+    // returns false if the time ran out before a subgraph was colored
+    auto colorBlocks = [&params, &timeLimitFunctor, &solve](
+        std::vector<solver::Block> const& blocks, std::vector<solver::Coloring> &colorings
+    ) {
+        std::vector<size_t> schedule(blocks.size());
+        std::iota(schedule.begin(), schedule.end(), 0);
+        std::ranges::stable_sort(schedule, std::greater{}, [&blocks](size_t b) {
+            return blocks[b].graph.NumEdges();
+        });
+
+        colorings.assign(blocks.size(), {});
+        std::vector<solver::ColorType> results(blocks.size(), -1);
+        std::vector<std::exception_ptr> errors(blocks.size());
+        std::atomic<size_t> next = 0;
+
+        auto worker = [&]() {
+            for (size_t i = next++; i < schedule.size(); i = next++) {
+                auto const b = schedule[i];
+                auto const& block = blocks[b].graph;
+                try {
+                    // two vertices at most need no solver
+                    if (block.NumVertices() <= 2) {
+                        colorings[b].assign(block.NumVertices(), 0);
+                        if (block.NumEdges() > 0) {
+                            colorings[b][1] = 1;
+                        }
+                        results[b] = block.NumEdges() + 1;
+                    } else {
+                        solver::ColorType proven = -1;
+                        results[b] = solve(block, params.config, colorings[b], timeLimitFunctor, nullptr, &proven, false);
+                        // BnB searched the block to the end without a coloring below its bound,
+                        // a heuristic one still does
+                        if (results[b] == -1 && proven != -1) {
+                            results[b] = solve(block, solver::DSATUR_BUCKET, colorings[b], timeLimitFunctor, nullptr, nullptr, false);
+                        }
+                    }
+                } catch (...) {
+                    errors[b] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < std::min(params.numThreads, blocks.size()); ++i) {
+            threads.emplace_back(worker);
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        for (auto const& error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return std::ranges::find(results, -1) == results.end();
+    };
+
+    // --decompose: the blocks are independent problems, stitched together at the cut vertices
+    auto split = [&colorBlocks, &colors](solver::Graph const& graph) -> solver::ColorType {
+        auto const decomposition = solver::BiconnectedBlocks(graph);
+        auto const& blocks = decomposition.blocks;
+
+        solver::SizeType largest = 0;
+        for (auto const& block: blocks) {
+            largest = std::max(largest, block.graph.NumVertices());
+        }
+        std::cout << "Components: " << decomposition.numComponents << ", blocks: " << blocks.size()
+            << ", largest block: " << largest << " vertices" << std::endl;
+
+        std::vector<solver::Coloring> colorings;
+        if (!colorBlocks(blocks, colorings)) {
+            return -1;
+        }
+        return solver::MergeColorings(graph, decomposition, colorings, colors);
+    };
+
+    // --divide: no edge joins two pieces, only the separator between them needs new colors
+    auto divide = [&params, &timeLimitFunctor, &colorBlocks, &colors](solver::Graph const& graph) -> solver::ColorType {
+        auto const partition = solver::SeparatorPartition(graph, params.pieceSize);
+        std::cout << "Pieces: " << partition.pieces.size() << ", separator: "
+            << partition.separator.size() << " vertices" << std::endl;
+
+        std::vector<solver::Coloring> colorings;
+        if (!colorBlocks(partition.pieces, colorings)) {
+            return -1;
+        }
+        solver::ColorType piecesColors = 0;
+        for (auto const& coloring: colorings) {
+            for (auto c: coloring) {
+                piecesColors = std::max(piecesColors, c + 1);
+            }
+        }
+
+        auto const ncolors = solver::JoinPieces(graph, partition, colorings, colors);
+        if (ncolors <= piecesColors) {
+            return ncolors;
+        }
+        // repairs stay around the separator, so does the budget
+        auto const budget = solver::heuristics::KEMPE_MOVES_PER_VERTEX * partition.separator.size();
+        auto const repaired = solver::heuristics::ReduceColors(graph, colors, ncolors, piecesColors, budget, timeLimitFunctor);
+        std::cout << "Separator repair: K=" << ncolors << " -> K=" << repaired << std::endl;
+        return repaired;
+    };
+
+    // set when BnB searched to the end without a coloring below this bound
+    solver::ColorType proven = -1;
+    try {
+        if (!params.portfolio.empty()) {
+            ncolors = compressed ? race(*compressed) : race(g);
+        } else if (compressed) {
+            ncolors = solve(*compressed, params.config, colors, timeLimitFunctor, nullptr, &proven, true);
+        } else if (params.decompose) {
+            ncolors = split(g);
+        } else if (params.pieceSize > 0) {
+            ncolors = divide(g);
+        } else {
+            ncolors = solve(g, params.config, colors, timeLimitFunctor, nullptr, &proven, true);
+        }
+    } catch(std::exception& e) {
+        isJobDone = true;
+        timerThread.join();
+        std::cerr << "\033[31m" << "Error: " << e.what() << "\033[0m" << std::endl;
+        return EXIT_FAILURE;
     }
 
     isJobDone = true;
@@ -185,6 +651,11 @@ int32_t main(int32_t argc, char **argv)
 
     timerThread.join();
 
+    if (ncolors == -1 && proven != -1) {
+        std::cout << "No coloring with fewer than " << proven << " colors." << std::endl;
+        return EXIT_FAILURE;
+    }
+
     if (ncolors == -1) {
         std::cout << "Time limit exceeded." << std::endl;
         return EXIT_FAILURE;
@@ -192,18 +663,25 @@ int32_t main(int32_t argc, char **argv)
 
     std::cout << boost::timer::format(times, 5, "Elapsed time: %w") << 's' << std::endl;
 
-    if (!solver::Validate(g, boost::get(&solver::VertexProperty::color, g))) {
+    if (kernel) {
+        auto const kernelColors = std::move(colors);
+        ncolors = solver::Unpeel(full, *kernel, kernelColors, colors);
+    }
+
+    if (!(kernel ? solver::Validate(full, colors) : compressed ? solver::Validate(*compressed, colors) : solver::Validate(g, colors))) {
         std::cout << "Bad coloring." << std::endl;
         return EXIT_FAILURE;
     }
 
     std::cout << "Found coloring K=" << ncolors << std::endl;
 
-    auto colors = boost::get(&solver::VertexProperty::color, g);
-    std::array<std::set<uint64_t>, 4> colorClasses;
-    for (auto v: boost::make_iterator_range(boost::vertices(g))) {
-        auto c = colors[v];
-        colorClasses[c].emplace(v);
+    if (!order.empty()) {
+        colors = solver::RestoreColoring(colors, order);
+    }
+
+    std::vector<std::set<uint64_t>> colorClasses(ncolors);
+    for (solver::Vertex v = 0; v < colors.size(); ++v) {
+        colorClasses[colors[v]].emplace(v);
     }
 
     for (auto& cls: colorClasses) {
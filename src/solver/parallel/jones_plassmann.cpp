@@ -0,0 +1,148 @@
+#include "jones_plassmann.h"
+
+#include <algorithm>
+#include <barrier>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace solver::parallel {
+namespace detail {
+// splitmix64 finalizer, spreads consecutive ids over the whole range
+uint64_t Mix(uint64_t x) noexcept
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+template <typename GraphType>
+ColorType JonesPlassmann(
+    GraphType const& g, Coloring &coloring, size_t numThreads, uint64_t seed,
+    TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    auto const n = g.NumVertices();
+    numThreads = std::max<size_t>(1, std::min<size_t>(numThreads, n));
+
+    coloring.assign(n, 0);
+    if (n == 0) {
+        return 0;
+    }
+
+    // degree in the high half, hash in the low half, id breaks the remaining ties
+    std::vector<uint64_t> priority(n);
+    auto higher = [&priority](Vertex u, Vertex v) {
+        return priority[u] != priority[v] ? priority[u] > priority[v] : u > v;
+    };
+
+    // number of uncolored higher-priority neighbours
+    std::vector<std::atomic<uint32_t>> waiting(n);
+
+    std::vector<Vertex> frontier;
+    std::vector<std::vector<Vertex>> next(numThreads);
+    std::vector<ColorType> maxColor(numThreads, 0);
+    bool done = false;
+    bool timeLimitExceeded = false;
+
+    // runs on one thread between the phases: gathers the vertices that became ready
+    auto onPhaseEnd = [&]() noexcept {
+        frontier.clear();
+        for (auto &ready: next) {
+            frontier.insert(frontier.end(), ready.begin(), ready.end());
+            ready.clear();
+        }
+        done = frontier.empty();
+        if (!done && timeLimitFunctor()) {
+            done = timeLimitExceeded = true;
+        }
+    };
+    std::barrier sync(numThreads, onPhaseEnd);
+
+    auto worker = [&](size_t t) {
+        Vertex const first = t * n / numThreads;
+        Vertex const last = (t + 1) * n / numThreads;
+
+        for (Vertex v = first; v < last; ++v) {
+            priority[v] = (uint64_t(g.Degree(v)) << 32) | uint32_t(Mix(seed ^ Mix(v)));
+        }
+        sync.arrive_and_wait();
+
+        for (Vertex v = first; v < last; ++v) {
+            uint32_t count = 0;
+            for (auto u: g.Neighbours(v)) {
+                count += higher(u, v);
+            }
+            waiting[v].store(count, std::memory_order_relaxed);
+            if (count == 0) {
+                next[t].push_back(v);
+            }
+        }
+        sync.arrive_and_wait();
+
+        // colors seen around the current vertex, stamped with its id + 1
+        std::vector<Vertex> seen;
+        while (!done) {
+            size_t const size = frontier.size();
+            for (size_t i = t * size / numThreads; i < (t + 1) * size / numThreads; ++i) {
+                Vertex const v = frontier[i];
+
+                for (auto u: g.Neighbours(v)) {
+                    if (higher(u, v)) {
+                        auto const c = static_cast<size_t>(coloring[u]);
+                        if (c >= seen.size()) {
+                            seen.resize(c + 1, 0);
+                        }
+                        seen[c] = v + 1;
+                    }
+                }
+                ColorType c = 0;
+                while (static_cast<size_t>(c) < seen.size() && seen[c] == v + 1) {
+                    ++c;
+                }
+                coloring[v] = c;
+                maxColor[t] = std::max(maxColor[t], c + 1);
+
+                for (auto u: g.Neighbours(v)) {
+                    if (higher(v, u) && waiting[u].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                        next[t].push_back(u);
+                    }
+                }
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    if (timeLimitExceeded) {
+        return -1;
+    }
+    return *std::max_element(maxColor.begin(), maxColor.end());
+}
+} // namespace detail
+
+ColorType JonesPlassmann(
+    Graph const& g, Coloring &coloring, size_t numThreads, uint64_t seed,
+    TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::JonesPlassmann(g, coloring, numThreads, seed, timeLimitFunctor);
+}
+
+ColorType JonesPlassmann(
+    CompressedGraph const& g, Coloring &coloring, size_t numThreads, uint64_t seed,
+    TimeLimitFuncCRef timeLimitFunctor
+)
+{
+    return detail::JonesPlassmann(g, coloring, numThreads, seed, timeLimitFunctor);
+}
+} // namespace solver::parallel
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "../compressed_graph.h"
+#include "../graph.h"
+
+namespace solver::parallel {
+// Jones-Plassmann coloring: every vertex gets a priority, largest degree first with
+// ties broken by a hash of the seed and the vertex id, and is colored with the
+// smallest color missing among its higher-priority neighbours as soon as all of
+// them are colored. The result equals greedy coloring in priority order, so it does
+// not depend on the number of threads. Returns -1 when the time limit is exceeded.
+ColorType JonesPlassmann(
+    Graph const& g, Coloring &coloring, size_t numThreads, uint64_t seed,
+    TimeLimitFuncCRef timeLimitFunctor
+);
+ColorType JonesPlassmann(
+    CompressedGraph const& g, Coloring &coloring, size_t numThreads, uint64_t seed,
+    TimeLimitFuncCRef timeLimitFunctor
+);
+} // namespace solver::parallel
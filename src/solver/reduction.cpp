@@ -0,0 +1,77 @@
+#include "reduction.h"
+
+#include <algorithm>
+
+namespace solver {
+Graph InducedSubgraph(Graph const& g, std::vector<Vertex> const& vertices, std::vector<Vertex> const& newId)
+{
+    utils::AdjacencyArrays adjacency;
+    adjacency.offsets.resize(vertices.size() + 1);
+    adjacency.offsets[0] = 0;
+    for (Vertex i = 0; i < vertices.size(); ++i) {
+        for (auto u: g.Neighbours(vertices[i])) {
+            // ids keep their relative order, so the lists stay sorted
+            if (newId[u] != NO_VERTEX) {
+                adjacency.targets.push_back(newId[u]);
+            }
+        }
+        adjacency.offsets[i + 1] = adjacency.targets.size();
+    }
+    return Graph(std::move(adjacency));
+}
+
+Kernel PeelLowDegree(Graph const& g, SizeType k)
+{
+    auto const n = g.NumVertices();
+
+    // the queue holds the vertices whose degree has dropped below k: a bucket queue
+    // with one bucket, as only the threshold matters
+    std::vector<SizeType> degree(n);
+    std::vector<uint8_t> removed(n, false);
+    Kernel kernel;
+    auto &queue = kernel.peeled;
+    queue.reserve(n);
+
+    for (Vertex v = 0; v < n; ++v) {
+        degree[v] = g.Degree(v);
+        if (degree[v] < k) {
+            removed[v] = true;
+            queue.push_back(v);
+        }
+    }
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        for (auto u: g.Neighbours(queue[i])) {
+            if (!removed[u] && --degree[u] < k) {
+                removed[u] = true;
+                queue.push_back(u);
+            }
+        }
+    }
+
+    std::vector<Vertex> newId(n, NO_VERTEX);
+    for (Vertex v = 0; v < n; ++v) {
+        if (!removed[v]) {
+            newId[v] = kernel.kept.size();
+            kernel.kept.push_back(v);
+        }
+    }
+
+    kernel.graph = InducedSubgraph(g, kernel.kept, newId);
+
+    return kernel;
+}
+
+ColorType Unpeel(Graph const& g, Kernel const& kernel, Coloring const& kernelColoring, Coloring &coloring)
+{
+    coloring.assign(g.NumVertices(), -1);
+
+    ColorType ncolors = 0;
+    for (Vertex i = 0; i < kernel.kept.size(); ++i) {
+        coloring[kernel.kept[i]] = kernelColoring[i];
+        ncolors = std::max(ncolors, kernelColoring[i] + 1);
+    }
+
+    return std::max(ncolors, FirstFit(g, std::views::reverse(kernel.peeled), coloring));
+}
+} // namespace solver
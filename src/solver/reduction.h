@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <ranges>
+
+#include "graph.h"
+
+namespace solver {
+// vertex that is not part of a subgraph
+Vertex constexpr NO_VERTEX = std::numeric_limits<Vertex>::max();
+
+// Subgraph of g induced by vertices: newId[v] is the id of v in the subgraph, or NO_VERTEX
+// if v is left out. vertices[newId[v]] == v, ids must keep the order of g for sorted lists.
+Graph InducedSubgraph(Graph const& g, std::vector<Vertex> const& vertices, std::vector<Vertex> const& newId);
+
+// Colors vertices in the given order with the smallest color missing among their colored
+// neighbours, the others have color -1. Returns the number of colors of the given vertices.
+template <std::ranges::input_range Range>
+ColorType FirstFit(Graph const& g, Range&& vertices, Coloring &coloring)
+{
+    ColorType ncolors = 0;
+
+    // colors around the current vertex, stamped with its id + 1
+    std::vector<Vertex> seen;
+    for (Vertex const v: vertices) {
+        for (auto u: g.Neighbours(v)) {
+            if (coloring[u] < 0) {
+                continue;
+            }
+            if (static_cast<size_t>(coloring[u]) >= seen.size()) {
+                seen.resize(coloring[u] + 1, 0);
+            }
+            seen[coloring[u]] = v + 1;
+        }
+
+        ColorType c = 0;
+        while (static_cast<size_t>(c) < seen.size() && seen[c] == v + 1) {
+            ++c;
+        }
+        coloring[v] = c;
+        ncolors = std::max(ncolors, c + 1);
+    }
+
+    return ncolors;
+}
+
+// Graph left after repeatedly removing vertices of degree below k. Any coloring of
+// the kernel with at least k colors extends to the peeled vertices without new ones.
+struct Kernel {
+    Graph graph;
+    // kept[kernelId] == original id
+    std::vector<Vertex> kept;
+    // original ids in removal order
+    std::vector<Vertex> peeled;
+};
+
+Kernel PeelLowDegree(Graph const& g, SizeType k);
+
+// Extends a coloring of kernel.graph to g: kernel vertices keep their colors, peeled
+// vertices are colored first fit in reverse removal order. Returns the number of colors.
+ColorType Unpeel(Graph const& g, Kernel const& kernel, Coloring const& kernelColoring, Coloring &coloring);
+} // namespace solver
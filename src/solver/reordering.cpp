@@ -0,0 +1,179 @@
+#include "reordering.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <cctype>
+
+namespace solver {
+std::istream &operator>>(std::istream& in, Ordering& ordering)
+{
+    std::string token;
+    in >> token;
+
+    for (auto &ch: token) {
+        ch = std::tolower(ch);
+    }
+
+    if (token == "none") {
+        ordering = Ordering::NONE;
+    } else if (token == "bfs") {
+        ordering = Ordering::BFS;
+    } else if (token == "degree") {
+        ordering = Ordering::DEGREE;
+    } else if (token == "hilbert") {
+        ordering = Ordering::HILBERT;
+    } else {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+Permutation CuthillMcKeeOrder(Graph const& g)
+{
+    auto const n = g.NumVertices();
+
+    auto byDegree = [&g](Vertex lhs, Vertex rhs) {
+        return g.Degree(lhs) < g.Degree(rhs);
+    };
+
+    // every component is started from its lowest degree vertex
+    Permutation roots(n);
+    std::iota(roots.begin(), roots.end(), 0);
+    std::stable_sort(roots.begin(), roots.end(), byDegree);
+
+    Permutation order;
+    order.reserve(n);
+    std::vector<uint8_t> visited(n, false);
+
+    for (auto root: roots) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        order.push_back(root);
+
+        // order doubles as the BFS queue
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            size_t const first = order.size();
+            for (auto u: g.Neighbours(order[head])) {
+                if (!visited[u]) {
+                    visited[u] = true;
+                    order.push_back(u);
+                }
+            }
+            std::stable_sort(order.begin() + first, order.end(), byDegree);
+        }
+    }
+    return order;
+}
+
+Permutation DegreeOrder(Graph const& g)
+{
+    Permutation order(g.NumVertices());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&g](Vertex lhs, Vertex rhs) {
+        return g.Degree(lhs) > g.Degree(rhs);
+    });
+    return order;
+}
+
+namespace {
+// Distance of cell (x, y) along the Hilbert curve filling a 2^ORDER x 2^ORDER grid.
+uint64_t HilbertIndex(uint32_t x, uint32_t y)
+{
+    static uint32_t constexpr ORDER = 32;
+
+    uint64_t d = 0;
+    for (uint64_t s = uint64_t(1) << (ORDER - 1); s > 0; s >>= 1) {
+        uint32_t const rx = (x & s) > 0;
+        uint32_t const ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+
+        // rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = ~x;
+                y = ~y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+} // namespace
+
+Permutation HilbertOrder(std::span<Coordinate const> coordinates)
+{
+    auto const n = coordinates.size();
+    if (n == 0) {
+        return {};
+    }
+
+    int64_t minX = coordinates[0].first, minY = coordinates[0].second;
+    for (auto [x, y]: coordinates) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+    }
+
+    uint64_t span = 0;
+    for (auto [x, y]: coordinates) {
+        span = std::max({span, uint64_t(x - minX), uint64_t(y - minY)});
+    }
+
+    // bounding box is scaled down to 32 bits per axis, keeping aspect ratio
+    uint32_t shift = 0;
+    while ((span >> shift) > UINT32_MAX) {
+        ++shift;
+    }
+
+    std::vector<std::pair<uint64_t, Vertex>> keys(n);
+    for (Vertex v = 0; v < n; ++v) {
+        auto x = uint32_t(uint64_t(coordinates[v].first - minX) >> shift);
+        auto y = uint32_t(uint64_t(coordinates[v].second - minY) >> shift);
+        keys[v] = {HilbertIndex(x, y), v};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    Permutation order(n);
+    for (Vertex i = 0; i < n; ++i) {
+        order[i] = keys[i].second;
+    }
+    return order;
+}
+
+Graph Relabel(Graph const& g, Permutation const& order)
+{
+    auto const n = g.NumVertices();
+
+    Permutation newId(n);
+    for (Vertex i = 0; i < n; ++i) {
+        newId[order[i]] = i;
+    }
+
+    utils::AdjacencyArrays adjacency;
+    adjacency.offsets.resize(n + 1);
+    adjacency.targets.resize(2 * g.NumEdges());
+
+    adjacency.offsets[0] = 0;
+    for (Vertex i = 0; i < n; ++i) {
+        auto neighbours = g.Neighbours(order[i]);
+        auto first = adjacency.targets.begin() + adjacency.offsets[i];
+        auto last = std::transform(neighbours.begin(), neighbours.end(), first, [&newId](Vertex u) {
+            return newId[u];
+        });
+        std::sort(first, last);
+        adjacency.offsets[i + 1] = adjacency.offsets[i] + neighbours.size();
+    }
+    return Graph(std::move(adjacency));
+}
+
+Coloring RestoreColoring(Coloring const& coloring, Permutation const& order)
+{
+    Coloring result(coloring.size());
+    for (Vertex i = 0; i < coloring.size(); ++i) {
+        result[order[i]] = coloring[i];
+    }
+    return result;
+}
+} // namespace solver
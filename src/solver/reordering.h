@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <utility>
+#include <vector>
+#include <span>
+
+#include "graph.h"
+
+namespace solver {
+enum class Ordering: uint8_t {
+    NONE,
+    BFS,        // Cuthill-McKee: BFS from a low degree vertex, neighbours by ascending degree
+    DEGREE,     // descending degree, the order DSATUR tends to color in
+    HILBERT,    // Hilbert curve over vertex coordinates
+};
+
+std::istream &operator>>(std::istream& in, Ordering& ordering);
+
+using Coordinate = std::pair<int64_t, int64_t>;
+
+// order[newId] == oldId
+using Permutation = std::vector<Vertex>;
+
+Permutation CuthillMcKeeOrder(Graph const& g);
+Permutation DegreeOrder(Graph const& g);
+Permutation HilbertOrder(std::span<Coordinate const> coordinates);
+
+// Returns g with vertex order[i] renamed to i.
+Graph Relabel(Graph const& g, Permutation const& order);
+
+// Moves colors of the relabeled graph back to the original ids.
+Coloring RestoreColoring(Coloring const& coloring, Permutation const& order);
+} // namespace solver
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <concepts>
+
+#include "../graph.h"
+
+namespace solver::selectors {
+// Picks the next vertex to color. DSATUR cores are instantiated per selector,
+// so every call below is resolved at compile time.
+template <typename Selector>
+concept CandidateSelector = requires(Selector s, SizeType n, DSaturState const& state, Vertex v, Graph const& g) {
+    s.Init(n, state);
+    s.Push(v);
+    { s.Pop(g) } -> std::same_as<Vertex>;
+    { s.Empty() } -> std::same_as<bool>;
+};
+
+// Selectors that order candidates by saturation must be told when it grows.
+// The others leave Update out and the call is compiled away.
+template <typename Selector>
+concept UpdatableSelector = CandidateSelector<Selector> && requires(Selector s, Vertex v) {
+    s.Update(v);
+};
+// Selectors that cache scores over neighbourhoods are told about every change of the
+// neighbour colors or the colored flag of a vertex, including undo steps of BnB.
+template <typename Selector, typename GraphType>
+concept TrackingSelector = requires(Selector s, Vertex v, GraphType const& g) {
+    s.Changed(v, g);
+};
+
+template <typename Selector, typename GraphType>
+void NotifyChanged(Selector &selector, Vertex v, GraphType const& g)
+{
+    if constexpr (TrackingSelector<Selector, GraphType>) {
+        selector.Changed(v, g);
+    }
+}
+} // namespace solver::selectors
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "candidate_selector.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <vector>
+#include <bit>
+
+namespace solver::selectors {
+namespace detail {
+// Set of integers in [0, n) as a 64-ary tree of bit words: a bit on level k + 1
+// tells that the matching word on level k is non-zero. Insert, Erase and Max touch
+// one word per level, which is at most 6 levels for 32-bit ranks.
+class RankSet {
+public:
+    void Init(SizeType n)
+    {
+        mLevels.clear();
+        do {
+            n = (n + 63) / 64;
+            mLevels.emplace_back(n, 0);
+        } while (n > 1);
+    }
+
+    bool Empty() const noexcept
+    {
+        return mLevels.back()[0] == 0;
+    }
+
+    void Insert(SizeType r) noexcept
+    {
+        for (auto &level: mLevels) {
+            uint64_t &word = level[r / 64];
+            bool const wasEmpty = word == 0;
+            word |= uint64_t(1) << (r % 64);
+            if (!wasEmpty) {
+                return;
+            }
+            r /= 64;
+        }
+    }
+
+    void Erase(SizeType r) noexcept
+    {
+        for (auto &level: mLevels) {
+            uint64_t &word = level[r / 64];
+            word &= ~(uint64_t(1) << (r % 64));
+            if (word != 0) {
+                return;
+            }
+            r /= 64;
+        }
+    }
+
+    // the set must not be empty
+    SizeType Max() const noexcept
+    {
+        SizeType r = 0;
+        for (auto level = mLevels.rbegin(); level != mLevels.rend(); ++level) {
+            r = r * 64 + 63 - std::countl_zero((*level)[r]);
+        }
+        return r;
+    }
+
+private:
+    std::vector<std::vector<uint64_t>> mLevels;
+};
+} // namespace detail
+
+// Saturation-indexed buckets. Inside a bucket vertices are ordered by their rank in
+// the (degree, index) order, which never changes during coloring, so the pick is the
+// same as with CompareInfo of the heap selectors: saturation, then degree, then index.
+class BucketCandidateSelector {
+public:
+    // saturation counts bits of a 32-bit mask
+    static size_t constexpr NUM_BUCKETS = 33;
+
+    void Init(SizeType n, DSaturState const& state)
+    {
+        mState = &state;
+
+        mVertexOf.resize(n);
+        std::iota(mVertexOf.begin(), mVertexOf.end(), 0);
+        std::stable_sort(mVertexOf.begin(), mVertexOf.end(), [&state](Vertex lhs, Vertex rhs) {
+            return state.degree[lhs] < state.degree[rhs];
+        });
+
+        mRank.resize(n);
+        for (Vertex r = 0; r < n; ++r) {
+            mRank[mVertexOf[r]] = r;
+        }
+
+        mBucketOf.assign(n, 0);
+        mBuckets.assign(NUM_BUCKETS, {});
+        mBucketSize = n;
+        mNonEmpty = 0;
+        mAllocated = 0;
+    }
+
+    void Push(Vertex v)
+    {
+        auto const s = mState->Saturation(v);
+        mBucketOf[v] = s;
+        Bucket(s).Insert(mRank[v]);
+        mNonEmpty |= uint64_t(1) << s;
+    }
+
+    template <typename GraphType>
+    Vertex Pop(GraphType const&)
+    {
+        auto const s = 63 - std::countl_zero(mNonEmpty);
+        auto const v = mVertexOf[mBuckets[s].Max()];
+        Remove(v);
+        return v;
+    }
+
+    bool Empty() const
+    {
+        return mNonEmpty == 0;
+    }
+
+    void Update(Vertex v)
+    {
+        if (mBucketOf[v] == mState->Saturation(v)) {
+            return;
+        }
+        Remove(v);
+        Push(v);
+    }
+
+private:
+    // buckets are allocated on first use, most saturation values never occur
+    detail::RankSet &Bucket(SizeType s)
+    {
+        if (!(mAllocated & (uint64_t(1) << s))) {
+            mBuckets[s].Init(mBucketSize);
+            mAllocated |= uint64_t(1) << s;
+        }
+        return mBuckets[s];
+    }
+
+    void Remove(Vertex v)
+    {
+        auto const s = mBucketOf[v];
+        mBuckets[s].Erase(mRank[v]);
+        if (mBuckets[s].Empty()) {
+            mNonEmpty &= ~(uint64_t(1) << s);
+        }
+    }
+
+    DSaturState const *mState { nullptr };
+
+    // vertex of every rank and back
+    std::vector<Vertex> mVertexOf;
+    std::vector<Vertex> mRank;
+
+    std::vector<uint8_t> mBucketOf;
+    std::vector<detail::RankSet> mBuckets;
+    SizeType mBucketSize { 0 };
+
+    uint64_t mNonEmpty { 0 };
+    uint64_t mAllocated { 0 };
+};
+} // namespace solver::selectors
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "candidate_selector.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <vector>
+
+namespace solver::selectors {
+// Implicit 4-ary max-heap of vertex ids in one array, with the position of every
+// vertex kept aside, so Update sifts the vertex up in place. Vertices are ordered as
+// by CompareInfo of the sparse selectors: saturation, then degree, then index; the
+// last two are folded into a static rank and the whole key fits into 64 bits.
+class DaryHeapCandidateSelector {
+public:
+    static uint32_t constexpr ARITY = 4;
+
+    void Init(SizeType n, DSaturState const& state)
+    {
+        mState = &state;
+
+        std::vector<Vertex> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&state](Vertex lhs, Vertex rhs) {
+            return state.degree[lhs] < state.degree[rhs];
+        });
+
+        mKey.resize(n);
+        for (Vertex r = 0; r < n; ++r) {
+            mKey[order[r]] = r;
+        }
+
+        mHeap.clear();
+        mHeap.reserve(n);
+        mPosition.assign(n, NOT_IN_HEAP);
+    }
+
+    void Push(Vertex v)
+    {
+        mKey[v] = Key(v);
+        mHeap.push_back(v);
+        SiftUp(mHeap.size() - 1);
+    }
+
+    template <typename GraphType>
+    Vertex Pop(GraphType const&)
+    {
+        Vertex chosen = mHeap.front();
+        mPosition[chosen] = NOT_IN_HEAP;
+
+        Vertex last = mHeap.back();
+        mHeap.pop_back();
+        if (!mHeap.empty()) {
+            SiftDown(0, last);
+        }
+        return chosen;
+    }
+
+    bool Empty() const
+    {
+        return mHeap.empty();
+    }
+
+    // saturation only grows, so the vertex can only move up
+    void Update(Vertex v)
+    {
+        auto const key = Key(v);
+        if (mPosition[v] == NOT_IN_HEAP || key == mKey[v]) {
+            return;
+        }
+        mKey[v] = key;
+        SiftUp(mPosition[v]);
+    }
+
+private:
+    static uint32_t constexpr NOT_IN_HEAP = UINT32_MAX;
+
+    uint64_t Key(Vertex v) const noexcept
+    {
+        return (uint64_t(mState->Saturation(v)) << 32) | uint32_t(mKey[v]);
+    }
+
+    void Place(SizeType pos, Vertex v) noexcept
+    {
+        mHeap[pos] = v;
+        mPosition[v] = pos;
+    }
+
+    void SiftUp(SizeType pos) noexcept
+    {
+        Vertex const v = mHeap[pos];
+        uint64_t const key = mKey[v];
+        while (pos > 0) {
+            SizeType const parent = (pos - 1) / ARITY;
+            if (mKey[mHeap[parent]] >= key) {
+                break;
+            }
+            Place(pos, mHeap[parent]);
+            pos = parent;
+        }
+        Place(pos, v);
+    }
+
+    // puts v into the hole at pos and moves it down
+    void SiftDown(SizeType pos, Vertex v) noexcept
+    {
+        uint64_t const key = mKey[v];
+        SizeType const size = mHeap.size();
+        while (true) {
+            SizeType const first = pos * ARITY + 1;
+            if (first >= size) {
+                break;
+            }
+
+            SizeType best = first;
+            SizeType const last = std::min(first + ARITY, size);
+            for (SizeType child = first + 1; child < last; ++child) {
+                if (mKey[mHeap[child]] > mKey[mHeap[best]]) {
+                    best = child;
+                }
+            }
+            if (mKey[mHeap[best]] <= key) {
+                break;
+            }
+            Place(pos, mHeap[best]);
+            pos = best;
+        }
+        Place(pos, v);
+    }
+
+    DSaturState const *mState { nullptr };
+
+    std::vector<Vertex> mHeap;
+    std::vector<uint32_t> mPosition;
+    // saturation in the high half, (degree, index) rank in the low half
+    std::vector<uint64_t> mKey;
+};
+} // namespace solver::selectors
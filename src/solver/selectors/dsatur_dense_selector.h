@@ -1,11 +1,12 @@
 #pragma once
 
-#include "icandidate_selector.h"
+#include "saturation_scan.h"
+#include "candidate_selector.h"
 
 #include <vector>
 
 namespace solver::selectors {
-class DenseCandidateSelector final: public ICandidateSelector {
+class DenseCandidateSelector {
 public:
     using Info = std::pair<SizeType, SizeType>;
     struct CompareInfo {
@@ -18,33 +19,30 @@ public:
         }
     };
 
-    void Init(SizeType n, DataMap dataMap) override final
+    void Init(SizeType n, DSaturState const& state)
     {
-        mDataMap = dataMap;
+        mState = &state;
         mUncolored.reserve(n);
+        mCandidates.resize(n);
     }
 
-    void Push(Vertex i) override final
+    void Push(Vertex i)
     {
         mUncolored.push_back(i);
     }
 
-    Vertex Pop(Graph const&) override final
+    template <typename GraphType>
+    Vertex Pop(GraphType const&)
     {
-        SizeType maxSat = 0;
-        for (size_t i = 0; i < mUncolored.size(); ++i) {
-            SizeType v = mUncolored[i];
-            maxSat = std::max(maxSat, Data(v)->Saturation());
-        }
+        SizeType maxSat = scan::MaxSaturation(mState->saturation, mUncolored);
+        auto const numCandidates = scan::CollectSaturated(mState->saturation, mUncolored, maxSat, mCandidates.data());
 
         int32_t bestIndex = -1;
         Info bestCandidate;
-        for (size_t i = 0; i < mUncolored.size(); ++i) {
+        for (size_t k = 0; k < numCandidates; ++k) {
+            size_t i = mCandidates[k];
             SizeType v = mUncolored[i];
-            if (Data(v)->Saturation() != maxSat) {
-                continue;
-            }
-            Info info(Data(v)->degree, v);
+            Info info(mState->degree[v], v);
             if (bestIndex == -1 || CompareInfo{}(bestCandidate, info)) {
                 bestCandidate = info;
                 bestIndex = i;
@@ -56,19 +54,16 @@ public:
         return bestCandidate.second;
     }
 
-    bool Empty() override final
+    bool Empty() const
     {
         return mUncolored.empty();
     }
 
 private:
-    DSaturData *Data(Vertex v)
-    {
-        return static_cast<DSaturData *>(mDataMap[v].get());
-    }
-
-    DataMap mDataMap;
+    DSaturState const *mState { nullptr };
 
     std::vector<Vertex> mUncolored;
+    // positions in mUncolored with the max saturation
+    std::vector<uint32_t> mCandidates;
 };
 } // namespace solver::selectors
\ No newline at end of file
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "icandidate_selector.h"
-
-#include <boost/range/iterator_range.hpp>
+#include "saturation_scan.h"
+#include "candidate_selector.h"
+#include "same_score_cache.h"
 
 #include <vector>
 
 namespace solver::selectors {
-class PassCandidateSelector final: public ICandidateSelector {
+class PassCandidateSelector {
 public:
     using Info = std::pair<SizeType, SizeType>;
     struct CompareInfo {
@@ -20,51 +20,39 @@ public:
         }
     };
 
-    void Init(SizeType n, DataMap dataMap) override final
+    void Init(SizeType n, DSaturState const& state)
     {
-        mDataMap = dataMap;
+        mState = &state;
         mUncolored.reserve(n);
+        mCandidates.resize(n);
+        mSame.Init(n);
     }
 
-    void Push(Vertex i) override final
+    void Push(Vertex i)
     {
         mUncolored.push_back(i);
     }
 
-    Vertex Pop(Graph const& g) override final
+    template <typename GraphType>
+    Vertex Pop(GraphType const& g)
     {
-        static std::vector<SizeType> T;
-        T.resize(0);
-        SizeType maxSat = 0;
-
-        for (size_t i = 0; i < mUncolored.size(); ++i) {
-            SizeType v = mUncolored[i];
-            
-            if (auto sat = Data(v)->Saturation(); sat > maxSat) {
-                T.resize(0);
-                maxSat = sat;
-            }
-
-            T.emplace_back(i);
-        }
+        SizeType maxSat = scan::MaxSaturation(mState->saturation, mUncolored);
+        auto const numCandidates = scan::CollectSaturated(mState->saturation, mUncolored, maxSat, mCandidates.data());
 
-        // TODO: change method of getting currentMaxColor
-        auto mu = Data(mUncolored[0])->currentMaxColor - maxSat;
+        auto mu = *mState->currentMaxColor - maxSat;
 
         int32_t bestIndex = -1;
         Info bestCandidate;
-        for (auto i: T) {
+        for (size_t k = 0; k < numCandidates; ++k) {
+            size_t i = mCandidates[k];
             SizeType v = mUncolored[i];
-            if (Data(v)->Saturation() != maxSat) {
-                continue;
-            }
-            
+
             Info info;
 
             if (mu <= TH) {
                 info = {Same(v, maxSat, g), v}; // PASS
             } else {
-                info = {Data(v)->degree, v}; // DSATUR
+                info = {mState->degree[v], v}; // DSATUR
             }
             
             if (bestIndex == -1 || CompareInfo{}(bestCandidate, info)) {
@@ -78,32 +66,40 @@ public:
         return bestCandidate.second;
     }
     
-    bool Empty() override final
+    bool Empty() const
     {
         return mUncolored.empty();
     }
 
-private:
-    SizeType Same(Vertex v, SizeType maxSat, Graph const& g)
+    template <typename GraphType>
+    void Changed(Vertex v, GraphType const& g)
     {
-        SizeType totalAdmissibleColors = 0;
-        for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
-            if (Data(u)->colored || Data(u)->Saturation() != maxSat) {
-                continue;
-            }
-            totalAdmissibleColors += Data(v)->F() & Data(u)->F();
-        }
-        return totalAdmissibleColors;
+        mSame.Invalidate(v, g);
     }
 
-    DSaturData *Data(Vertex v)
+private:
+    template <typename GraphType>
+    SizeType Same(Vertex v, SizeType maxSat, GraphType const& g)
     {
-        return static_cast<DSaturData *>(mDataMap[v].get());
+        return mSame.Get(v, (uint64_t(maxSat) << 32) | uint32_t(*mState->currentMaxColor), [this, v, maxSat, &g]() {
+            SizeType totalAdmissibleColors = 0;
+            for (auto u: g.Neighbours(v)) {
+                if (mState->colored[u] || mState->Saturation(u) != maxSat) {
+                    continue;
+                }
+                totalAdmissibleColors += mState->F(v) & mState->F(u);
+            }
+            return totalAdmissibleColors;
+        });
     }
 
-    DataMap mDataMap;
+    DSaturState const *mState { nullptr };
 
     std::vector<Vertex> mUncolored;
+    // positions in mUncolored with the max saturation
+    std::vector<uint32_t> mCandidates;
+
+    SameScoreCache mSame;
 
     static size_t constexpr TH = 2; 
 };
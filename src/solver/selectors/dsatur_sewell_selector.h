@@ -1,13 +1,13 @@
 #pragma once
 
-#include "icandidate_selector.h"
-
-#include <boost/range/iterator_range.hpp>
+#include "saturation_scan.h"
+#include "candidate_selector.h"
+#include "same_score_cache.h"
 
 #include <vector>
 
 namespace solver::selectors {
-class SewellCandidateSelector final: public ICandidateSelector {
+class SewellCandidateSelector {
 public:
     using Info = std::pair<SizeType, SizeType>;
     struct CompareInfo {
@@ -20,32 +20,30 @@ public:
         }
     };
 
-    void Init(SizeType n, DataMap dataMap) override final
+    void Init(SizeType n, DSaturState const& state)
     {
-        mDataMap = dataMap;
+        mState = &state;
         mUncolored.reserve(n);
+        mCandidates.resize(n);
+        mSame.Init(n);
     }
 
-    void Push(Vertex i) override final
+    void Push(Vertex i)
     {
         mUncolored.push_back(i);
     }
 
-    Vertex Pop(Graph const& g) override final
+    template <typename GraphType>
+    Vertex Pop(GraphType const& g)
     {
-        SizeType maxSat = 0;
-        for (size_t i = 0; i < mUncolored.size(); ++i) {
-            SizeType v = mUncolored[i];
-            maxSat = std::max(maxSat, Data(v)->Saturation());
-        }
+        SizeType maxSat = scan::MaxSaturation(mState->saturation, mUncolored);
+        auto const numCandidates = scan::CollectSaturated(mState->saturation, mUncolored, maxSat, mCandidates.data());
 
         int32_t bestIndex = -1;
         Info bestCandidate;
-        for (size_t i = 0; i < mUncolored.size(); ++i) {
+        for (size_t k = 0; k < numCandidates; ++k) {
+            size_t i = mCandidates[k];
             SizeType v = mUncolored[i];
-            if (Data(v)->Saturation() != maxSat) {
-                continue;
-            }
             Info info(Same(v, g), v);
             if (bestIndex == -1 || CompareInfo{}(bestCandidate, info)) {
                 bestCandidate = info;
@@ -58,31 +56,39 @@ public:
         return bestCandidate.second;
     }
     
-    bool Empty() override final
+    bool Empty() const
     {
         return mUncolored.empty();
     }
 
-private:
-    SizeType Same(Vertex v, Graph const& g)
+    template <typename GraphType>
+    void Changed(Vertex v, GraphType const& g)
     {
-        SizeType totalAdmissibleColors = 0;
-        for (auto u: boost::make_iterator_range(boost::adjacent_vertices(v, g))) {
-            if (Data(u)->colored) {
-                continue;
-            }
-            totalAdmissibleColors += Data(v)->F() & Data(u)->F();
-        }
-        return totalAdmissibleColors;
+        mSame.Invalidate(v, g);
     }
 
-    DSaturData *Data(Vertex v)
+private:
+    template <typename GraphType>
+    SizeType Same(Vertex v, GraphType const& g)
     {
-        return static_cast<DSaturData *>(mDataMap[v].get());
+        return mSame.Get(v, uint64_t(*mState->currentMaxColor), [this, v, &g]() {
+            SizeType totalAdmissibleColors = 0;
+            for (auto u: g.Neighbours(v)) {
+                if (mState->colored[u]) {
+                    continue;
+                }
+                totalAdmissibleColors += mState->F(v) & mState->F(u);
+            }
+            return totalAdmissibleColors;
+        });
     }
 
-    DataMap mDataMap;
+    DSaturState const *mState { nullptr };
 
     std::vector<Vertex> mUncolored;
+    // positions in mUncolored with the max saturation
+    std::vector<uint32_t> mCandidates;
+
+    SameScoreCache mSame;
 };
 } // namespace solver::selectors
\ No newline at end of file
@@ -1,65 +1,61 @@
 #pragma once
 
-#include "icandidate_selector.h"
+#include "candidate_selector.h"
 
 #include <boost/heap/binomial_heap.hpp>
 #include <boost/heap/fibonacci_heap.hpp>
 
 namespace solver::selectors {
 template<template <typename T, class... Options> class HeapType>
-class SparseCandidateSelector final: public ICandidateSelector {
+class SparseCandidateSelector {
 public:
     struct CompareInfo {
-        bool operator()(DataType lhs, DataType rhs) const {
-            if (Data(lhs)->Saturation() != Data(rhs)->Saturation()) {
-                return Data(lhs)->Saturation() < Data(rhs)->Saturation();
+        DSaturState const *state { nullptr };
+
+        bool operator()(Vertex lhs, Vertex rhs) const {
+            if (state->Saturation(lhs) != state->Saturation(rhs)) {
+                return state->Saturation(lhs) < state->Saturation(rhs);
             }
-            if (Data(lhs)->degree != Data(rhs)->degree) {
-                return Data(lhs)->degree < Data(rhs)->degree;
+            if (state->degree[lhs] != state->degree[rhs]) {
+                return state->degree[lhs] < state->degree[rhs];
             }
-            return Data(lhs)->index < Data(rhs)->index;
+            return lhs < rhs;
         }
     };
 
-    using Heap = HeapType<DataType, boost::heap::compare<CompareInfo>>;
+    using Heap = HeapType<Vertex, boost::heap::compare<CompareInfo>>;
     using HandleType = typename Heap::handle_type;
 
-    void Init(SizeType n, DataMap dataMap) override final
+    void Init(SizeType n, DSaturState const& state)
     {
-        mDataMap = dataMap;
+        mUncolored = Heap(CompareInfo{&state});
         mHandles.resize(n);
     }
 
-    void Push(Vertex v) override final
+    void Push(Vertex v)
     {
-        mHandles[v] = mUncolored.push(mDataMap[v]);
+        mHandles[v] = mUncolored.push(v);
     }
 
-    Vertex Pop(Graph const&) override final
+    template <typename GraphType>
+    Vertex Pop(GraphType const&)
     {
-        DataType chosen = mUncolored.top();
+        Vertex chosen = mUncolored.top();
         mUncolored.pop();
-        return Data(chosen)->index;
+        return chosen;
     }
     
-    bool Empty() override final
+    bool Empty() const
     {
         return mUncolored.empty();
     }
 
-    void Update(Vertex v) override final
+    void Update(Vertex v)
     {
-        mUncolored.increase(mHandles[v], mDataMap[v]);
+        mUncolored.increase(mHandles[v]);
     }
 
 private:
-    static DSaturData *Data(DataType data)
-    {
-        return static_cast<DSaturData *>(data.get());
-    }
-
-    DataMap mDataMap;
-
     Heap mUncolored;
     std::vector<HandleType> mHandles;
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../graph.h"
+
+namespace solver::selectors {
+// "Same" scores of the SEWELL and PASS selectors. The score of v depends only on
+// F(v) and on the colored flags and F() of its neighbours, so a change of a vertex
+// makes stale the scores of the vertex itself and of its neighbours: after coloring
+// one vertex only its 2-hop neighbourhood is recomputed, on the next request.
+// The key covers everything else a score depends on (max color, max saturation).
+class SameScoreCache {
+public:
+    void Init(SizeType n)
+    {
+        mScore.assign(n, 0);
+        mKey.assign(n, 0);
+        mFresh.assign(n, false);
+    }
+
+    template <typename GraphType>
+    void Invalidate(Vertex v, GraphType const& g)
+    {
+        mFresh[v] = false;
+        for (auto u: g.Neighbours(v)) {
+            mFresh[u] = false;
+        }
+    }
+
+    template <typename Compute>
+    SizeType Get(Vertex v, uint64_t key, Compute&& compute)
+    {
+        if (!mFresh[v] || mKey[v] != key) {
+            mScore[v] = compute();
+            mKey[v] = key;
+            mFresh[v] = true;
+        }
+        return mScore[v];
+    }
+
+private:
+    std::vector<SizeType> mScore;
+    std::vector<uint64_t> mKey;
+    std::vector<uint8_t> mFresh;
+};
+} // namespace solver::selectors
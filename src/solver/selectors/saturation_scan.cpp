@@ -0,0 +1,159 @@
+#include "saturation_scan.h"
+
+#include <algorithm>
+#include <limits>
+#include <bit>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SOLVER_X86_KERNELS 1
+#endif
+
+namespace solver::selectors::scan {
+namespace {
+uint32_t MaxScalar(uint32_t const *saturation, Vertex const *ids, size_t n)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < n; ++i) {
+        result = std::max(result, saturation[ids[i]]);
+    }
+    return result;
+}
+
+size_t CollectScalar(uint32_t const *saturation, Vertex const *ids, size_t n, uint32_t target, uint32_t *out)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (saturation[ids[i]] == target) {
+            out[count++] = i;
+        }
+    }
+    return count;
+}
+
+#ifdef SOLVER_X86_KERNELS
+__attribute__((target("avx2")))
+uint32_t MaxAvx2(uint32_t const *saturation, Vertex const *ids, size_t n)
+{
+    auto const base = reinterpret_cast<int const *>(saturation);
+
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ids + i));
+        acc = _mm256_max_epu32(acc, _mm256_i32gather_epi32(base, index, 4));
+    }
+
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    return std::max(*std::max_element(lanes, lanes + 8), MaxScalar(saturation, ids + i, n - i));
+}
+
+__attribute__((target("avx2")))
+size_t CollectAvx2(uint32_t const *saturation, Vertex const *ids, size_t n, uint32_t target, uint32_t *out)
+{
+    auto const base = reinterpret_cast<int const *>(saturation);
+    __m256i const needle = _mm256_set1_epi32(target);
+
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ids + i));
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_i32gather_epi32(base, index, 4), needle);
+        for (uint32_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal)); mask; mask &= mask - 1) {
+            out[count++] = i + std::countr_zero(mask);
+        }
+    }
+
+    size_t const tail = CollectScalar(saturation, ids + i, n - i, target, out + count);
+    for (size_t k = count; k < count + tail; ++k) {
+        out[k] += i;
+    }
+    return count + tail;
+}
+
+__attribute__((target("avx512f")))
+uint32_t MaxAvx512(uint32_t const *saturation, Vertex const *ids, size_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i index = _mm512_loadu_si512(ids + i);
+        acc = _mm512_max_epu32(acc, _mm512_i32gather_epi32(index, saturation, 4));
+    }
+
+    alignas(64) uint32_t lanes[16];
+    _mm512_store_si512(lanes, acc);
+    return std::max(*std::max_element(lanes, lanes + 16), MaxScalar(saturation, ids + i, n - i));
+}
+
+__attribute__((target("avx512f")))
+size_t CollectAvx512(uint32_t const *saturation, Vertex const *ids, size_t n, uint32_t target, uint32_t *out)
+{
+    __m512i const needle = _mm512_set1_epi32(target);
+    __m512i const lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i index = _mm512_loadu_si512(ids + i);
+        __mmask16 equal = _mm512_cmpeq_epi32_mask(_mm512_i32gather_epi32(index, saturation, 4), needle);
+        __m512i positions = _mm512_add_epi32(lanes, _mm512_set1_epi32(i));
+        _mm512_mask_compressstoreu_epi32(out + count, equal, positions);
+        count += std::popcount(static_cast<uint32_t>(equal));
+    }
+
+    size_t const tail = CollectScalar(saturation, ids + i, n - i, target, out + count);
+    for (size_t k = count; k < count + tail; ++k) {
+        out[k] += i;
+    }
+    return count + tail;
+}
+#endif
+
+struct Kernels {
+    uint32_t (*max)(uint32_t const *, Vertex const *, size_t);
+    size_t (*collect)(uint32_t const *, Vertex const *, size_t, uint32_t, uint32_t *);
+};
+
+Kernels const& SimdKernels()
+{
+    static Kernels const kernels = []() -> Kernels {
+#ifdef SOLVER_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return {MaxAvx512, CollectAvx512};
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return {MaxAvx2, CollectAvx2};
+        }
+#endif
+        return {MaxScalar, CollectScalar};
+    }();
+    return kernels;
+}
+
+Kernels const& Select(std::span<uint32_t const> saturation)
+{
+    // gathers take signed 32-bit indices, larger graphs stay on the scalar path
+    static Kernels constexpr scalar { MaxScalar, CollectScalar };
+    if (saturation.size() > size_t(std::numeric_limits<int32_t>::max())) {
+        return scalar;
+    }
+    return SimdKernels();
+}
+} // namespace
+
+uint32_t MaxSaturation(std::span<uint32_t const> saturation, std::span<Vertex const> ids)
+{
+    return Select(saturation).max(saturation.data(), ids.data(), ids.size());
+}
+
+size_t CollectSaturated(
+    std::span<uint32_t const> saturation, std::span<Vertex const> ids,
+    uint32_t target, uint32_t *out
+)
+{
+    return Select(saturation).collect(saturation.data(), ids.data(), ids.size(), target, out);
+}
+} // namespace solver::selectors::scan
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "../graph.h"
+
+namespace solver::selectors::scan {
+// Kernels over the saturation of a list of vertices. AVX-512 or AVX2 versions are
+// picked once by CPU detection, the scalar ones run everywhere else.
+
+// max saturation[ids[i]], 0 for an empty list
+uint32_t MaxSaturation(std::span<uint32_t const> saturation, std::span<Vertex const> ids);
+
+// Writes positions i with saturation[ids[i]] == target to out in increasing order,
+// returns their number. out must have room for ids.size() positions.
+size_t CollectSaturated(
+    std::span<uint32_t const> saturation, std::span<Vertex const> ids,
+    uint32_t target, uint32_t *out
+);
+} // namespace solver::selectors::scan